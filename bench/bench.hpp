@@ -0,0 +1,71 @@
+#pragma once
+/**
+@file
+minimal benchmark harness: timing loop and heap allocation counter
+
+NOTE: replaces global operator new/delete, so include it from one translation unit
+of a benchmark executable only.
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+//number of heap allocations done so far
+inline std::size_t s_allocs = 0;
+
+inline std::size_t allocations()        { return s_allocs; }
+
+//prevent the compiler from optimizing the value away
+template <class T>
+inline void keep(T const& v)            { asm volatile("" : : "g"(&v) : "memory"); }
+
+//number of iterations from command line or default
+inline std::size_t iterations(int argc, char** argv, std::size_t def)
+{
+	return (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : def;
+}
+
+struct result
+{
+	double      ns;     //per iteration
+	std::size_t allocs; //per all iterations
+};
+
+template <class FUNC>
+inline result run(char const* name, std::size_t count, FUNC&& func)
+{
+	auto const allocs = allocations();
+	auto const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < count; ++i) { func(); }
+	auto const elapsed = std::chrono::steady_clock::now() - start;
+
+	result const res{
+		double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / (count ? count : 1),
+		allocations() - allocs
+	};
+	std::printf("%-40s %10.1f ns/op %8zu allocs\n", name, res.ns, res.allocs);
+	return res;
+}
+
+} //end: namespace bench
+
+void* operator new(std::size_t size)
+{
+	++bench::s_allocs;
+	if (void* p = std::malloc(size ? size : 1)) { return p; }
+	throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)                  { return ::operator new(size); }
+void operator delete(void* p) noexcept                  { std::free(p); }
+void operator delete[](void* p) noexcept                { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept     { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept   { std::free(p); }
@@ -0,0 +1,149 @@
+/**
+@file
+Credit-Control CCR-U/CCA-U round trip: encode and decode must not touch the heap
+
+usage: bench_credit_control [iterations]
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <string_view>
+
+#include "med/encoder_context.hpp"
+#include "med/decoder_context.hpp"
+#include "med/octet_encoder.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/encode.hpp"
+#include "med/decode.hpp"
+
+#include "diameter/credit_control.hpp"
+
+#include "bench.hpp"
+
+using namespace std::string_view_literals;
+namespace cc = diameter::cc;
+using mscc_avp = cc::multiple_services_credit_control;
+
+namespace {
+
+std::size_t encode_ccr(uint8_t (&buffer)[2048])
+{
+	std::size_t alloc_buf[256];
+	med::allocator alloc{alloc_buf};
+
+	cc::base dia;
+	cc::CCR& msg = dia.select();
+	dia.header().flags().proxiable(true);
+	dia.header().ap_id(uint32_t(diameter::APPLICATION::DCCA));
+	dia.header().hop_id(0x22222222);
+	dia.header().end_id(0x55555555);
+
+	msg.ref<diameter::session_id>().set("pgw.example.net", "gy");
+	msg.ref<diameter::origin_host>().set("pgw.example.net"sv);
+	msg.ref<diameter::origin_realm>().set("example.net"sv);
+	msg.ref<diameter::destination_realm>().set("ocs.example.net"sv);
+	msg.ref<diameter::auth_application_id>().set(diameter::APPLICATION::DCCA);
+	msg.ref<cc::service_context_id>().set("32251@3gpp.org"sv);
+	msg.ref<cc::cc_request_type>().set(cc::CC_REQUEST_TYPE::UPDATE_REQUEST);
+	msg.ref<cc::cc_request_number>().set(1);
+	msg.ref<diameter::origin_state_id>().set(7);
+	{
+		auto* sub = msg.ref<cc::subscription_id>().push_back(alloc);
+		sub->ref<cc::subscription_id_type>().set(cc::SUBSCRIPTION_ID_TYPE::END_USER_IMSI);
+		sub->ref<cc::subscription_id_data>().set("001010123456789"sv);
+	}
+	msg.ref<cc::multiple_services_indicator>().set(cc::MULTIPLE_SERVICES_INDICATOR::MULTIPLE_SERVICES_SUPPORTED);
+	for (uint32_t rg = 1; rg <= 2; ++rg)
+	{
+		auto* mscc = msg.ref<mscc_avp>().push_back(alloc);
+		mscc->ref<cc::requested_service_unit>().ref<cc::cc_total_octets>().set(uint64_t(1) << 20);
+		auto* usu = mscc->ref<cc::used_service_unit>().push_back(alloc);
+		usu->ref<cc::cc_total_octets>().set(uint64_t(3) << 18);
+		usu->ref<cc::cc_input_octets>().set(uint64_t(1) << 18);
+		usu->ref<cc::cc_output_octets>().set(uint64_t(1) << 19);
+		usu->ref<cc::cc_time>().set(60);
+		mscc->ref<cc::rating_group>().set(rg);
+	}
+
+	med::encoder_context<> ctx{buffer};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+std::size_t encode_cca(uint8_t (&buffer)[2048], cc::CCR const& req)
+{
+	std::size_t alloc_buf[256];
+	med::allocator alloc{alloc_buf};
+
+	cc::base dia;
+	cc::CCA& msg = dia.select();
+	dia.header().flags().proxiable(true);
+	dia.header().ap_id(uint32_t(diameter::APPLICATION::DCCA));
+	dia.header().hop_id(0x22222222);
+	dia.header().end_id(0x55555555);
+
+	msg.ref<diameter::session_id>().set(req.get<diameter::session_id>());
+	msg.ref<diameter::result_code>().set(diameter::RESULT::SUCCESS);
+	msg.ref<diameter::origin_host>().set("ocs.example.net"sv);
+	msg.ref<diameter::origin_realm>().set("example.net"sv);
+	msg.ref<diameter::auth_application_id>().set(diameter::APPLICATION::DCCA);
+	msg.ref<cc::cc_request_type>().set(req.get<cc::cc_request_type>().get());
+	msg.ref<cc::cc_request_number>().set(req.get<cc::cc_request_number>().get());
+	for (auto const& in : req.get<mscc_avp>())
+	{
+		auto* mscc = msg.ref<mscc_avp>().push_back(alloc);
+		mscc->ref<cc::granted_service_unit>().ref<cc::cc_total_octets>().set(uint64_t(1) << 20);
+		mscc->ref<cc::rating_group>().set(in.get<cc::rating_group>()->get());
+		mscc->ref<cc::validity_time>().set(3600);
+		mscc->ref<diameter::result_code>().set(diameter::RESULT::SUCCESS);
+	}
+
+	med::encoder_context<> ctx{buffer};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const count = bench::iterations(argc, argv, 1'000'000);
+
+	uint8_t ccr[2048];
+	uint8_t cca[2048];
+	std::size_t const ccr_size = encode_ccr(ccr);
+	std::size_t cca_size = 0;
+
+	auto const res = bench::run("CCR-U/CCA-U round trip", count, [&]
+	{
+		//server: decode CCR and answer
+		{
+			std::size_t alloc_buf[256];
+			med::allocator alloc{alloc_buf};
+			med::decoder_context<med::allocator> ctx{ccr, ccr_size, &alloc};
+			cc::base dia;
+			decode(med::octet_decoder{ctx}, dia);
+			cca_size = encode_cca(cca, *dia.cselect());
+		}
+		//client: decode CCA
+		{
+			std::size_t alloc_buf[256];
+			med::allocator alloc{alloc_buf};
+			med::decoder_context<med::allocator> ctx{cca, cca_size, &alloc};
+			cc::base dia;
+			decode(med::octet_decoder{ctx}, dia);
+			cc::CCA const* msg = dia.cselect();
+			bench::keep(msg->get<diameter::result_code>().get());
+		}
+	});
+	std::printf("CCR=%zu CCA=%zu bytes\n", ccr_size, cca_size);
+
+	if (res.allocs)
+	{
+		std::printf("FAILED: %zu heap allocations on CCR/CCA hot path\n", res.allocs);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,118 @@
+/**
+@file
+proxy change of Destination-Host in ~2KB CCR: med decode and re-encode vs copy-on-write editor
+(both must produce the same bytes)
+
+usage: bench_editor [iterations]
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstring>
+#include <string_view>
+
+#include "med/encoder_context.hpp"
+#include "med/decoder_context.hpp"
+#include "med/octet_encoder.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/encode.hpp"
+#include "med/decode.hpp"
+
+#include "diameter/credit_control.hpp"
+#include "diameter/editor.hpp"
+
+#include "bench.hpp"
+
+using namespace std::string_view_literals;
+namespace cc = diameter::cc;
+
+namespace {
+
+constexpr auto NEW_HOST = "ocs2.example.net"sv;
+
+//CCR-U with fields in the order of cc::CCR
+std::size_t make_ccr(uint8_t (&buffer)[4096])
+{
+	diameter::avp_writer w{buffer, sizeof(buffer)};
+	w.header(diameter::REQUEST | cc::CCR::code, uint32_t(diameter::APPLICATION::DCCA), 0x22222222, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("pgw.example.net;1514764800;1;gy"sv);
+	w.add<diameter::origin_host>("pgw.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::destination_realm>("ocs.example.net"sv);
+	w.add<diameter::auth_application_id>(diameter::APPLICATION::DCCA);
+	w.add<cc::service_context_id>("32251@3gpp.org"sv);
+	w.add<cc::cc_request_type>(cc::CC_REQUEST_TYPE::UPDATE_REQUEST);
+	w.add<cc::cc_request_number>(1u);
+	w.add<diameter::destination_host>("ocs1.example.net"sv);
+	w.add<diameter::origin_state_id>(7u);
+	for (uint32_t rg = 1; rg <= 12; ++rg)
+	{
+		auto const mscc = w.begin_group<cc::multiple_services_credit_control>();
+		{
+			auto const usu = w.begin_group<cc::used_service_unit>();
+			w.add<cc::cc_time>(60u);
+			w.add<cc::cc_total_octets>(uint64_t(3) << 18);
+			w.add<cc::cc_input_octets>(uint64_t(1) << 18);
+			w.add<cc::cc_output_octets>(uint64_t(1) << 19);
+			w.end_group(usu);
+		}
+		w.add<cc::service_identifier>(1000 + rg);
+		w.add<cc::rating_group>(rg);
+		w.end_group(mscc);
+	}
+	for (std::size_t i = 0; i < 16; ++i)
+	{
+		w.add<diameter::route_record>("dra.region.example.net"sv);
+	}
+	return w.finish();
+}
+
+std::size_t med_edit(uint8_t const* in, std::size_t size, uint8_t (&out)[4096])
+{
+	std::size_t alloc_buf[512];
+	med::allocator alloc{alloc_buf};
+	med::decoder_context<med::allocator> dctx{in, size, &alloc};
+	cc::base dia;
+	decode(med::octet_decoder{dctx}, dia);
+
+	cc::CCR& msg = dia.select();
+	msg.ref<diameter::destination_host>().set(NEW_HOST);
+
+	med::encoder_context<> ctx{out};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+std::size_t cow_edit(uint8_t const* in, std::size_t size, uint8_t (&out)[4096])
+{
+	diameter::editor ed{in, size};
+	ed.set<diameter::destination_host>(NEW_HOST);
+	return ed.encode(out, sizeof(out));
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const count = bench::iterations(argc, argv, 1'000'000);
+
+	uint8_t ccr[4096];
+	std::size_t const size = make_ccr(ccr);
+
+	uint8_t expected[4096], actual[4096];
+	std::size_t const exp_size = med_edit(ccr, size, expected);
+	if (exp_size != cow_edit(ccr, size, actual) || std::memcmp(expected, actual, exp_size))
+	{
+		std::printf("editor output differs from med\n");
+		return 1;
+	}
+
+	std::printf("CCR: %zu bytes\n", size);
+	auto const med = bench::run("  med decode+encode", count, [&] { bench::keep(med_edit(ccr, size, actual)); });
+	auto const cow = bench::run("  editor", count, [&] { bench::keep(cow_edit(ccr, size, actual)); });
+	auto const copy = bench::run("  memcpy", count, [&] { std::memcpy(actual, ccr, size); bench::keep(actual); });
+	std::printf("  editor/med = %.2f, editor/memcpy = %.2f\n", cow.ns / med.ns, cow.ns / copy.ns);
+	return (!med.allocs && !cow.allocs) ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/**
+@file
+decode and re-encode of small DWR: med header vs header_view (decode_message/encode_message)
+(both must produce the same bytes)
+
+usage: bench_header [iterations]
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstring>
+#include <string_view>
+
+#include "diameter/choice.hpp"
+#include "diameter/writer.hpp"
+
+#include "bench.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+std::size_t make_dwr(uint8_t (&buffer)[256])
+{
+	diameter::avp_writer w{buffer, sizeof(buffer)};
+	w.header(diameter::REQUEST | diameter::DWR::code, 0, 0x22222222, 0x55555555);
+	w.add<diameter::origin_host>("pgw.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::origin_state_id>(7u);
+	return w.finish();
+}
+
+std::size_t med_codec(uint8_t const* in, std::size_t size, uint8_t (&out)[256])
+{
+	std::size_t alloc_buf[64];
+	med::allocator alloc{alloc_buf};
+	med::decoder_context<med::allocator> dctx{in, size, &alloc};
+	diameter::base dia;
+	decode(med::octet_decoder{dctx}, dia);
+
+	med::encoder_context<> ctx{out};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+std::size_t view_codec(uint8_t const* in, std::size_t size, uint8_t (&out)[256])
+{
+	std::size_t alloc_buf[64];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	diameter::decode_message(dia, in, size, alloc);
+	return diameter::encode_message(dia, out, sizeof(out));
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const count = bench::iterations(argc, argv, 1'000'000);
+
+	uint8_t dwr[256];
+	std::size_t const size = make_dwr(dwr);
+
+	uint8_t expected[256], actual[256];
+	std::size_t const exp_size = med_codec(dwr, size, expected);
+	if (exp_size != size || exp_size != view_codec(dwr, size, actual) || std::memcmp(expected, actual, exp_size))
+	{
+		std::printf("header_view codec output differs from med\n");
+		return 1;
+	}
+
+	std::printf("DWR: %zu bytes\n", size);
+	auto const med = bench::run("  med header", count, [&] { bench::keep(med_codec(dwr, size, actual)); });
+	auto const view = bench::run("  header_view", count, [&] { bench::keep(view_codec(dwr, size, actual)); });
+	std::printf("  header_view/med = %.2f\n", view.ns / med.ns);
+	return (!med.allocs && !view.allocs) ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+/**
+@file
+decode of STR into a new diameter::base per message vs reused one from the pool
+
+usage: bench_pool [iterations]
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <string_view>
+
+#include "med/encoder_context.hpp"
+#include "med/decoder_context.hpp"
+#include "med/octet_encoder.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/encode.hpp"
+#include "med/decode.hpp"
+
+#include "diameter/base.hpp"
+#include "diameter/pool.hpp"
+
+#include "bench.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+std::size_t encode_str(uint8_t (&buffer)[1024])
+{
+	std::size_t alloc_buf[64];
+	med::allocator alloc{alloc_buf};
+
+	diameter::base dia;
+	diameter::STR& msg = dia.select();
+	dia.header().flags().proxiable(true);
+	dia.header().ap_id(uint32_t(diameter::APPLICATION::GX));
+	dia.header().hop_id(0x22222222);
+	dia.header().end_id(0x55555555);
+
+	msg.ref<diameter::session_id>().set("pgw.example.net", "gx");
+	msg.ref<diameter::origin_host>().set("pgw.example.net"sv);
+	msg.ref<diameter::origin_realm>().set("example.net"sv);
+	msg.ref<diameter::destination_realm>().set("pcrf.example.net"sv);
+	msg.ref<diameter::auth_application_id>().set(diameter::APPLICATION::GX);
+	msg.ref<diameter::termination_cause>().set(diameter::TERMINATION_CAUSE::LOGOUT);
+	msg.ref<diameter::origin_state_id>().set(7);
+	msg.ref<diameter::route_record>().push_back(alloc)->set("dra.example.net"sv);
+
+	med::encoder_context<> ctx{buffer};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+template <class DIA>
+void decode_str(uint8_t const* data, std::size_t size, DIA& dia)
+{
+	std::size_t alloc_buf[64];
+	med::allocator alloc{alloc_buf};
+	med::decoder_context<med::allocator> ctx{data, size, &alloc};
+	decode(med::octet_decoder{ctx}, dia);
+	diameter::STR const* msg = dia.cselect();
+	bench::keep(msg->template get<diameter::termination_cause>().get());
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const count = bench::iterations(argc, argv, 1'000'000);
+
+	uint8_t str[1024];
+	std::size_t const str_size = encode_str(str);
+	std::printf("sizeof(diameter::base)=%zu STR=%zu bytes\n", sizeof(diameter::base), str_size);
+
+	auto const fresh = bench::run("STR decode: new message", count, [&]
+	{
+		diameter::base dia;
+		decode_str(str, str_size, dia);
+	});
+
+	diameter::pool<diameter::base, 4> msgs;
+	auto const pooled = bench::run("STR decode: pooled message", count, [&]
+	{
+		auto dia = msgs.acquire();
+		decode_str(str, str_size, *dia);
+	});
+
+	std::printf("pooled/new = %.2f\n", pooled.ns / fresh.ns);
+	return (fresh.allocs || pooled.allocs) ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+/**
+@file
+decode cost vs number of AVPs: STR with Route-Record and CEA with Supported-Vendor-Id
+up to their maximums followed by unknown AVPs (Rating-Group), and CCR with Subscription-Id
+(known and unbounded) repeated, of 10..10000 AVPs in total: ns per AVP is reported for
+each size and the run fails if it grows over 4 times from 100 to 10000 AVPs (non-linear decode)
+
+usage: bench_scaling [iterations]
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "diameter/base.hpp"
+#include "diameter/credit_control.hpp"
+#include "diameter/text.hpp"
+#include "diameter/validate.hpp"
+#include "diameter/writer.hpp"
+
+#include "bench.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+constexpr std::size_t AVPS[] = {10, 100, 1'000, 10'000};
+//timed iterations of each size at least (one of 10000 AVPs is too noisy)
+constexpr std::size_t MIN_ITERATIONS = 20;
+//encoded message and decoded instances
+std::vector<uint8_t> s_message(1 << 20);
+std::size_t s_alloc_buf[1 << 20];
+
+//STR of total avps: mandatory ones, Route-Record and unknown AVPs
+std::size_t make_str(std::size_t avps)
+{
+	diameter::avp_writer w{s_message.data(), s_message.size()};
+	w.header(diameter::REQUEST | diameter::STR::code, 0, 0x22222222, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("pgw.example.net;1514764800;1"sv);
+	w.add<diameter::origin_host>("pgw.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::destination_realm>("example.net"sv);
+	w.add<diameter::auth_application_id>(diameter::APPLICATION::GX);
+	w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+	for (std::size_t i = 6; i < avps && i < 6 + diameter::MAX_ROUTE_RECORD; ++i)
+	{
+		char host[64];
+		diameter::text::sink s{host, sizeof(host)};
+		s.put("dra-"sv);
+		s.number(i);
+		s.put(".example.net"sv);
+		w.add<diameter::route_record>(s.str());
+	}
+	for (std::size_t i = 6 + diameter::MAX_ROUTE_RECORD; i < avps; ++i)
+	{
+		w.add<diameter::cc::rating_group>(uint32_t(i));
+	}
+	return w.finish();
+}
+
+//CEA of total avps: mandatory ones, Supported-Vendor-Id and unknown AVPs
+std::size_t make_cea(std::size_t avps)
+{
+	uint8_t const ip4[] = {10, 0, 0, 1};
+	diameter::avp_writer w{s_message.data(), s_message.size()};
+	w.header(diameter::CEA::code, 0, 0x22222222, 0x55555555);
+	w.add<diameter::result_code>(diameter::RESULT::SUCCESS);
+	w.add<diameter::origin_host>("dra.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::host_ip_address>(diameter::ip_address{ip4, sizeof(ip4)});
+	w.add<diameter::vendor_id>(diameter::VENDOR::NONE);
+	w.add<diameter::product_name>("base:dia"sv);
+	for (std::size_t i = 6; i < avps; ++i)
+	{
+		if (i < 6 + diameter::MAX_SUPPORTED_VENDOR) { w.add<diameter::supported_vendor_id>(uint32_t(i)); }
+		else { w.add<diameter::cc::rating_group>(uint32_t(i)); }
+	}
+	return w.finish();
+}
+
+//CCR of total avps: mandatory ones and Subscription-Id
+std::size_t make_ccr(std::size_t avps)
+{
+	namespace cc = diameter::cc;
+	diameter::avp_writer w{s_message.data(), s_message.size()};
+	w.header(diameter::REQUEST | cc::CCR::code, uint32_t(diameter::APPLICATION::DCCA), 0x22222222, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("pgw.example.net;1514764800;1;gy"sv);
+	w.add<diameter::origin_host>("pgw.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::destination_realm>("ocs.example.net"sv);
+	w.add<diameter::auth_application_id>(diameter::APPLICATION::DCCA);
+	w.add<cc::service_context_id>("32251@3gpp.org"sv);
+	w.add<cc::cc_request_type>(cc::CC_REQUEST_TYPE::UPDATE_REQUEST);
+	w.add<cc::cc_request_number>(1u);
+	for (std::size_t i = 8; i < avps; ++i)
+	{
+		char msisdn[32];
+		diameter::text::sink s{msisdn, sizeof(msisdn)};
+		s.number(48'600'000'000 + i);
+		auto const sub = w.begin_group<cc::subscription_id>();
+		w.add<cc::subscription_id_type>(cc::SUBSCRIPTION_ID_TYPE::END_USER_E164);
+		w.add<cc::subscription_id_data>(s.str());
+		w.end_group(sub);
+	}
+	return w.finish();
+}
+
+//ns per AVP of validation and full decode for each number of AVPs, false if decode failed, allocated or grew
+template <class MSG, class DIA, class MAKE>
+bool scale(char const* name, std::size_t count, MAKE&& make)
+{
+	double per_avp[std::size(AVPS)];
+	bool ok = true;
+	for (std::size_t n = 0; n < std::size(AVPS); ++n)
+	{
+		std::size_t const avps = AVPS[n];
+		std::size_t const size = make(avps);
+		//same number of AVPs decoded per size
+		std::size_t const iterations = (count * 10 / avps > MIN_ITERATIONS) ? (count * 10 / avps) : MIN_ITERATIONS;
+		std::printf("%s of %zu AVPs (%zu bytes)\n", name, avps, size);
+
+		auto const decode_once = [&]
+		{
+			med::allocator alloc{s_alloc_buf};
+			DIA dia;
+			auto const status = diameter::try_decode(dia, s_message.data(), size, alloc);
+			if (!status) { ok = false; }
+			bench::keep(dia);
+		};
+		//warm up: page faults of the message and the allocator buffer
+		decode_once();
+
+		auto const valid = bench::run("  validate", iterations, [&]
+		{
+			bench::keep(diameter::validate<MSG>(s_message.data(), size));
+		});
+		auto const decode = bench::run("  try_decode", iterations, decode_once);
+		per_avp[n] = decode.ns / avps;
+		std::printf("  %.1f ns/AVP\n", per_avp[n]);
+		ok = ok && !valid.allocs && !decode.allocs;
+	}
+
+	//10000 vs 100 AVPs (10 AVPs are dominated by the header and the fixed fields)
+	double const growth = per_avp[std::size(AVPS) - 1] / per_avp[1];
+	std::printf("%s: ns/AVP of %zu vs %zu AVPs = %.2f\n", name, AVPS[std::size(AVPS) - 1], AVPS[1], growth);
+	if (growth > 4)
+	{
+		std::printf("%s: decode grows faster than number of AVPs\n", name);
+		ok = false;
+	}
+	return ok;
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const count = bench::iterations(argc, argv, 100'000);
+	bool const str = scale<diameter::STR, diameter::base>("STR/Route-Record", count, make_str);
+	bool const cea = scale<diameter::CEA, diameter::base>("CEA/Supported-Vendor-Id", count, make_cea);
+	bool const ccr = scale<diameter::cc::CCR, diameter::cc::base>("CCR/Subscription-Id", count, make_ccr);
+	return (str && cea && ccr) ? 0 : 1;
+}
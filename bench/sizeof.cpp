@@ -0,0 +1,94 @@
+/**
+@file
+memory footprint report: sizeof of each message type vs bytes its compact storage uses
+
+usage: bench_sizeof
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+#include "diameter/base.hpp"
+#include "diameter/compact.hpp"
+#include "diameter/validate.hpp"
+
+namespace {
+
+//data size of AVP in the sample messages unless it has fixed width
+constexpr uint32_t VAR_SIZE = 16;
+
+//one instance of the field with zeroed data (only if mandatory when MANDATORY_ONLY)
+template <class TRAIT>
+void put_field(uint8_t*& p, bool mandatory_only)
+{
+	using field = typename TRAIT::type;
+	if constexpr (diameter::detail::has_code<field>::value)
+	{
+		if (mandatory_only && !TRAIT::mandatory) { return; }
+		uint32_t const vendor = diameter::detail::vendor_of<field>();
+		uint32_t const fixed = diameter::detail::fixed_size_of<field>();
+		uint32_t const size = fixed ? fixed : VAR_SIZE;
+		uint32_t const hdr_size = vendor ? 12 : 8;
+		diameter::detail::put_be32(p, field::id);
+		diameter::detail::put_be32(p + 4, ((vendor ? 0xC0u : 0x40u) << 24) | (hdr_size + size));
+		if (vendor) { diameter::detail::put_be32(p + 8, vendor); }
+		std::memset(p + hdr_size, 0, size);
+		p += hdr_size + size;
+	}
+}
+
+//sample encoded MSG with one instance of each (or each mandatory) field
+template <class MSG, std::size_t... I>
+std::size_t make_sample(uint8_t* buf, bool mandatory_only, std::index_sequence<I...>)
+{
+	using traits = diameter::detail::traits_of<MSG>;
+	uint8_t* p = buf + diameter::header_view::SIZE;
+	(put_field<std::tuple_element_t<I, traits>>(p, mandatory_only), ...);
+	diameter::header_view const hdr{1, 0, uint32_t(p - buf), uint32_t(MSG::code), 0, 0, 0};
+	hdr.encode(buf);
+	return hdr.length;
+}
+
+//bytes used by compact storage of the sample message
+template <class MSG>
+std::size_t footprint(bool mandatory_only)
+{
+	uint8_t buf[4096];
+	std::size_t const size = make_sample<MSG>(buf, mandatory_only
+		, std::make_index_sequence<std::tuple_size_v<diameter::detail::traits_of<MSG>>>{});
+	diameter::compact<MSG> msg;
+	return msg.assign(buf, size) ? msg.footprint() : 0;
+}
+
+template <class... MSGS>
+void report()
+{
+	std::printf("%-32s %8s %10s %10s %6s\n", "message", "sizeof", "mandatory", "all once", "fields");
+	(std::printf("%-32s %8zu %10zu %10zu %6zu\n", MSGS::name(), sizeof(MSGS)
+		, footprint<MSGS>(true), footprint<MSGS>(false), diameter::compact<MSGS>::count), ...);
+}
+
+} //end: namespace
+
+int main()
+{
+	report<
+		diameter::CER, diameter::CEA,
+		diameter::DPR, diameter::DPA,
+		diameter::DWR, diameter::DWA,
+		diameter::RAR, diameter::RAA,
+		diameter::STR, diameter::STA,
+		diameter::ASR, diameter::ASA,
+		diameter::ACR, diameter::ACA
+	>();
+	std::printf("%-32s %8zu\n", "diameter::base", sizeof(diameter::base));
+	std::printf("compact: bytes of the storage for a sample message with only mandatory AVPs and with\n"
+		"each known AVP once (%u bytes of data unless fixed width)\n", VAR_SIZE);
+	return 0;
+}
@@ -0,0 +1,139 @@
+/**
+@file
+encode of CEA and ACA by med vs direct avp_writer (both must produce the same bytes)
+
+usage: bench_writer [iterations]
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstring>
+#include <string_view>
+
+#include "med/encoder_context.hpp"
+#include "med/octet_encoder.hpp"
+#include "med/encode.hpp"
+
+#include "diameter/base.hpp"
+#include "diameter/writer.hpp"
+
+#include "bench.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+constexpr uint8_t IP4[] = {10, 0, 0, 1};
+constexpr uint8_t TIMESTAMP[] = {0xDE, 0x8A, 0x45, 0x80};
+
+std::size_t med_cea(uint8_t (&buffer)[1024])
+{
+	std::size_t alloc_buf[128];
+	med::allocator alloc{alloc_buf};
+
+	diameter::base dia;
+	diameter::CEA& msg = dia.select();
+	dia.header().ap_id(0);
+	dia.header().hop_id(0x22222222);
+	dia.header().end_id(0x55555555);
+
+	msg.ref<diameter::result_code>().set(diameter::RESULT::SUCCESS);
+	msg.ref<diameter::origin_host>().set("dra.example.net"sv);
+	msg.ref<diameter::origin_realm>().set("example.net"sv);
+	msg.ref<diameter::host_ip_address>().push_back(alloc)->set(sizeof(IP4), IP4);
+	msg.ref<diameter::vendor_id>().set(diameter::VENDOR::NONE);
+	msg.ref<diameter::product_name>().set("base:dia"sv);
+	msg.ref<diameter::origin_state_id>().set(7);
+	msg.ref<diameter::supported_vendor_id>().push_back(alloc)->set(diameter::VENDOR::TGPP);
+	msg.ref<diameter::auth_application_id>().push_back(alloc)->set(diameter::APPLICATION::GX);
+	msg.ref<diameter::acct_application_id>().push_back(alloc)->set(diameter::APPLICATION::NONE);
+
+	med::encoder_context<> ctx{buffer};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+std::size_t writer_cea(uint8_t (&buffer)[1024])
+{
+	diameter::avp_writer w{buffer, sizeof(buffer)};
+	w.header(diameter::CEA::code, 0, 0x22222222, 0x55555555);
+	w.add<diameter::result_code>(diameter::RESULT::SUCCESS);
+	w.add<diameter::origin_host>("dra.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::host_ip_address>(diameter::ip_address{IP4, sizeof(IP4)});
+	w.add<diameter::vendor_id>(diameter::VENDOR::NONE);
+	w.add<diameter::product_name>("base:dia"sv);
+	w.add<diameter::origin_state_id>(7u);
+	w.add<diameter::supported_vendor_id>(diameter::VENDOR::TGPP);
+	w.add<diameter::auth_application_id>(diameter::APPLICATION::GX);
+	w.add<diameter::acct_application_id>(diameter::APPLICATION::NONE);
+	return w.finish();
+}
+
+std::size_t med_aca(uint8_t (&buffer)[1024])
+{
+	diameter::base dia;
+	diameter::ACA& msg = dia.select();
+	dia.header().flags().proxiable(true);
+	dia.header().ap_id(uint32_t(diameter::APPLICATION::NONE));
+	dia.header().hop_id(0x22222222);
+	dia.header().end_id(0x55555555);
+
+	msg.ref<diameter::session_id>().set("pgw.example.net;1514764800;1;acct"sv);
+	msg.ref<diameter::result_code>().set(diameter::RESULT::SUCCESS);
+	msg.ref<diameter::origin_host>().set("ofcs.example.net"sv);
+	msg.ref<diameter::origin_realm>().set("example.net"sv);
+	msg.ref<diameter::acct_record_type>().set(diameter::ACCT_RECORD_TYPE::INTERIM_RECORD);
+	msg.ref<diameter::acct_record_number>().set(3);
+	msg.ref<diameter::acct_application_id>().set(diameter::APPLICATION::NONE);
+	msg.ref<diameter::event_timestamp>().set(sizeof(TIMESTAMP), TIMESTAMP);
+
+	med::encoder_context<> ctx{buffer};
+	encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+std::size_t writer_aca(uint8_t (&buffer)[1024])
+{
+	diameter::avp_writer w{buffer, sizeof(buffer)};
+	w.header(diameter::ACA::code, uint32_t(diameter::APPLICATION::NONE), 0x22222222, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("pgw.example.net;1514764800;1;acct"sv);
+	w.add<diameter::result_code>(diameter::RESULT::SUCCESS);
+	w.add<diameter::origin_host>("ofcs.example.net"sv);
+	w.add<diameter::origin_realm>("example.net"sv);
+	w.add<diameter::acct_record_type>(diameter::ACCT_RECORD_TYPE::INTERIM_RECORD);
+	w.add<diameter::acct_record_number>(3u);
+	w.add<diameter::acct_application_id>(diameter::APPLICATION::NONE);
+	w.add<diameter::event_timestamp>(TIMESTAMP, sizeof(TIMESTAMP));
+	return w.finish();
+}
+
+template <class MED, class WRITER>
+bool compare(char const* name, std::size_t count, MED&& by_med, WRITER&& by_writer)
+{
+	uint8_t expected[1024], actual[1024];
+	std::size_t const size = by_med(expected);
+	if (size != by_writer(actual) || std::memcmp(expected, actual, size))
+	{
+		std::printf("%s: writer output differs from med\n", name);
+		return false;
+	}
+
+	std::printf("%s: %zu bytes\n", name, size);
+	auto const med = bench::run("  med encode", count, [&] { bench::keep(by_med(actual)); });
+	auto const writer = bench::run("  avp_writer", count, [&] { bench::keep(by_writer(actual)); });
+	std::printf("  avp_writer/med = %.2f\n", writer.ns / med.ns);
+	return !med.allocs && !writer.allocs;
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	std::size_t const count = bench::iterations(argc, argv, 1'000'000);
+	bool const cea = compare("CEA", count, med_cea, writer_cea);
+	bool const aca = compare("ACA", count, med_aca, writer_aca);
+	return (cea && aca) ? 0 : 1;
+}
@@ -70,9 +70,10 @@ struct cmd_flags : med::value<uint8_t>
 	template <std::size_t N>
 	void print(char (&sz)[N]) const
 	{
+		static_assert(N > 4, "BUFFER TOO SHORT");
 		value_type const flags = get();
 #define PB(bit) (flags&bit)?(#bit)[0]:'.'
-		snprintf(sz, sizeof(sz)-1, "%c%c%c%c", PB(R), PB(P), PB(E), PB(T));
+		sz[0] = PB(R); sz[1] = PB(P); sz[2] = PB(E); sz[3] = PB(T); sz[4] = 0;
 #undef PB
 	}
 };
@@ -183,9 +184,10 @@ struct avp_flags : med::value<uint8_t>
 	template <std::size_t N>
 	void print(char (&sz)[N]) const
 	{
+		static_assert(N > 3, "BUFFER TOO SHORT");
 		value_type const flags = get();
 #define PB(bit) (flags&bit)?(#bit)[0]:'.'
-		std::snprintf(sz, sizeof(sz)-1, "%c%c%c", PB(V), PB(M), PB(P));
+		sz[0] = PB(V); sz[1] = PB(M); sz[2] = PB(P); sz[3] = 0;
 #undef PB
 	}
 };
@@ -249,6 +251,8 @@ struct avp_header : med::sequence<
 	using length_type = length;
 
 	static constexpr uint32_t id = CODE;
+	static constexpr uint8_t flags_value = FLAGS;
+	static constexpr VENDOR vendor_value = VND;
 
 	auto const& flags() const               { return this->template get<avp_flags>(); }
 	auto& flags()                           { return this->template ref<avp_flags>(); }
@@ -329,6 +333,10 @@ struct avp<
 	template <class T, class Enable = std::enable_if_t<std::is_pointer_v<decltype(std::declval<T const>().data())>>>
 	auto set(T const& v)                            { return set(v.size(), v.data()); }
 	auto set(std::size_t len, void const* data)     { return this->body().set(len, data); }
+
+	//ip_address of Address AVP (see address::compact)
+	template <class V = VALUE>
+	auto ip() const -> decltype(std::declval<V const&>().compact()) { return this->body().compact(); }
 };
 
 /***************************************************************
@@ -340,6 +348,8 @@ struct avp_grouped : detail::avp_header< med::set<AVPs...>, CODE, FLAGS, VND >
 {
 	static_assert(sizeof...(AVPs) > 1, "USE PLAIN AVP FOR SINGLE VALUE");
 
+	using set_type = med::set<AVPs...>;
+
 	template <class FIELD>
 	decltype(auto) ref()                    { return this->body().template ref<FIELD>(); }
 	template <class FIELD>
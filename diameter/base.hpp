@@ -14,6 +14,20 @@ Distributed under the MIT License
 
 namespace diameter {
 
+/*
+Maximum instances of multi-instance AVPs in messages: instances are held inline
+up to the maximum and more of them is AVP_OCCURS_TOO_MANY_TIMES (see validate).
+*/
+constexpr std::size_t MAX_HOST_IP_ADDRESS    = 8;
+constexpr std::size_t MAX_SUPPORTED_VENDOR   = 32;
+constexpr std::size_t MAX_APPLICATION_ID     = 32;
+constexpr std::size_t MAX_INBAND_SECURITY_ID = 4;
+constexpr std::size_t MAX_FAILED_AVP         = 8;
+constexpr std::size_t MAX_PROXY_INFO         = 8;
+constexpr std::size_t MAX_ROUTE_RECORD       = 64; //RFC6733 leaves it unbounded: long enough for multi-hop chains
+constexpr std::size_t MAX_REDIRECT_HOST      = 8;
+constexpr std::size_t MAX_CLASS              = 8;
+
 /*
 <CER> ::= < Diameter Header: 257, REQ >
 	{ Origin-Host }
@@ -33,15 +47,15 @@ namespace diameter {
 struct CER : med::set<
 	M< origin_host >,
 	M< origin_realm >,
-	M< host_ip_address, med::inf >,
+	M< host_ip_address, med::max<MAX_HOST_IP_ADDRESS> >,
 	M< vendor_id >,
 	M< product_name >,
 	O< origin_state_id >,
-	O< supported_vendor_id, med::inf >,
-	O< auth_application_id, med::inf >,
-	O< inband_security_id,  med::inf >,
-	O< acct_application_id, med::inf >,
-	O< vendor_specific_application_id, med::inf >,
+	O< supported_vendor_id, med::max<MAX_SUPPORTED_VENDOR> >,
+	O< auth_application_id, med::max<MAX_APPLICATION_ID> >,
+	O< inband_security_id,  med::max<MAX_INBAND_SECURITY_ID> >,
+	O< acct_application_id, med::max<MAX_APPLICATION_ID> >,
+	O< vendor_specific_application_id, med::max<MAX_APPLICATION_ID> >,
 	O< firmware_revision >,
 	O< any_avp, med::inf >
 >
@@ -73,17 +87,17 @@ struct CEA : med::set<
 	M< result_code >,
 	M< origin_host >,
 	M< origin_realm >,
-	M< host_ip_address, med::inf >,
+	M< host_ip_address, med::max<MAX_HOST_IP_ADDRESS> >,
 	M< vendor_id >,
 	M< product_name >,
 	O< origin_state_id >,
 	O< error_message >,
-	O< failed_avp, med::inf >,
-	O< supported_vendor_id, med::inf >,
-	O< auth_application_id, med::inf >,
-	O< inband_security_id,  med::inf >,
-	O< acct_application_id, med::inf >,
-	O< vendor_specific_application_id, med::inf >,
+	O< failed_avp, med::max<MAX_FAILED_AVP> >,
+	O< supported_vendor_id, med::max<MAX_SUPPORTED_VENDOR> >,
+	O< auth_application_id, med::max<MAX_APPLICATION_ID> >,
+	O< inband_security_id,  med::max<MAX_INBAND_SECURITY_ID> >,
+	O< acct_application_id, med::max<MAX_APPLICATION_ID> >,
+	O< vendor_specific_application_id, med::max<MAX_APPLICATION_ID> >,
 	O< firmware_revision >,
 	O< any_avp, med::inf >
 >
@@ -123,7 +137,7 @@ struct DPA : med::set<
 	M< origin_host >,
 	M< origin_realm >,
 	O< error_message >,
-	O< failed_avp, med::inf >,
+	O< failed_avp, med::max<MAX_FAILED_AVP> >,
 	O< any_avp, med::inf >
 >
 {
@@ -162,7 +176,7 @@ struct DWA : med::set<
 	M< origin_host >,
 	M< origin_realm >,
 	O< error_message >,
-	O< failed_avp, med::inf >,
+	O< failed_avp, med::max<MAX_FAILED_AVP> >,
 	O< origin_state_id >,
 	O< any_avp, med::inf >
 >
@@ -196,8 +210,8 @@ struct RAR : med::set<
 	M< re_auth_request_type >,
 	O< user_name >,
 	O< origin_state_id >,
-	O< proxy_info, med::inf >,
-	O< route_record, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
+	O< route_record, med::max<MAX_ROUTE_RECORD> >,
 	O< any_avp, med::inf >
 >
 {
@@ -232,10 +246,10 @@ struct RAA : med::set<
 	O< error_message >,
 	O< error_reporting_host >,
 	O< failed_avp >,
-	O< redirect_host, med::inf >,
+	O< redirect_host, med::max<MAX_REDIRECT_HOST> >,
 	O< redirect_host_usage >,
 	O< redirect_max_cache_time >,
-	O< proxy_info, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
 	O< any_avp, med::inf >
 >
 {
@@ -268,10 +282,10 @@ struct STR : med::set<
 	M< termination_cause >,
 	O< user_name >,
 	O< destination_host >,
-	O< Class, med::inf >,
+	O< Class, med::max<MAX_CLASS> >,
 	O< origin_state_id >,
-	O< proxy_info, med::inf >,
-	O< route_record, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
+	O< route_record, med::max<MAX_ROUTE_RECORD> >,
 	O< any_avp, med::inf >
 >
 {
@@ -303,15 +317,15 @@ struct STA : med::set<
 	M< origin_host >,
 	M< origin_realm >,
 	O< user_name >,
-	O< Class, med::inf >,
+	O< Class, med::max<MAX_CLASS> >,
 	O< error_message >,
 	O< error_reporting_host >,
 	O< failed_avp >,
 	O< origin_state_id >,
-	O< redirect_host, med::inf >,
+	O< redirect_host, med::max<MAX_REDIRECT_HOST> >,
 	O< redirect_host_usage >,
 	O< redirect_max_cache_time >,
-	O< proxy_info, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
 	O< any_avp, med::inf >
 >
 {
@@ -343,8 +357,8 @@ struct ASR : med::set<
 	M< termination_cause >,
 	O< user_name >,
 	O< origin_state_id >,
-	O< proxy_info, med::inf >,
-	O< route_record, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
+	O< route_record, med::max<MAX_ROUTE_RECORD> >,
 	O< any_avp, med::inf >
 >
 {
@@ -379,10 +393,10 @@ struct ASA : med::set<
 	O< error_message >,
 	O< error_reporting_host >,
 	O< failed_avp >,
-	O< redirect_host, med::inf >,
+	O< redirect_host, med::max<MAX_REDIRECT_HOST> >,
 	O< redirect_host_usage >,
 	O< redirect_max_cache_time >,
-	O< proxy_info, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
 	O< any_avp, med::inf >
 >
 {
@@ -431,8 +445,8 @@ struct ACR : med::set<
 	O< acct_realtime_required >,
 	O< origin_state_id >,
 	O< event_timestamp >,
-	O< proxy_info, med::inf >,
-	O< route_record, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
+	O< route_record, med::max<MAX_ROUTE_RECORD> >,
 	O< any_avp, med::inf >
 >
 {
@@ -484,7 +498,7 @@ struct ACA : med::set<
 	O< acct_realtime_required >,
 	O< origin_state_id >,
 	O< event_timestamp >,
-	O< proxy_info, med::inf >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
 	O< any_avp, med::inf >
 >
 {
@@ -8,13 +8,17 @@ Distributed under the MIT License
 (See accompanying file LICENSE or visit https://github.com/cppden/med)
 */
 
-#include <chrono>
-#include <arpa/inet.h>
+#include <cstdio>
+#include <cstring>
 
 #include "med/octet_string.hpp"
 #include "med/set.hpp"
 #include "avp.hpp"
+#include "clock.hpp"
 #include "enums.hpp"
+#include "ip.hpp"
+#include "lazy.hpp"
+#include "text.hpp"
 
 namespace diameter {
 
@@ -57,22 +61,46 @@ struct address : address_t
 		}
 	}
 
+	void set(in_addr const& v)          { set(sizeof(v), &v); }
+	void set(in6_addr const& v)         { set(sizeof(v), &v); }
+	void set(ip_address const& v)       { set(v.size(), v.data()); }
+
+	//from IPv4/IPv6 text, false if it's invalid
+	bool parse(std::string_view s)
+	{
+		uint8_t ip[16];
+		std::size_t const len = text::parse_ip(s, ip);
+		if (len) { set(len, ip); }
+		return len != 0;
+	}
+
+	uint16_t family() const
+	{
+		return (this->size() >= 2) ? uint16_t((this->data()[0] << 8) | this->data()[1]) : 0;
+	}
+
+	//false if address is of other family
+	bool get(in_addr& v) const          { return compact().get(v); }
+	bool get(in6_addr& v) const         { return compact().get(v); }
+
+	//empty if family and length don't match
+	ip_address compact() const
+	{
+		uint16_t const af = family();
+		std::size_t const len = this->size();
+		if ((af == IPV4 && len == 6) || (af == IPV6 && len == 18)) { return ip_address{this->data() + 2, len - 2}; }
+		return ip_address{};
+	}
+
 	static constexpr char const* name() { return "Address"; }
 
 	template <std::size_t N>
 	void print(char (&sz)[N]) const
 	{
-		uint8_t const* p = this->data() + 2;
-		if (6 == this->size())
-		{
-			snprintf(sz, sizeof(sz), "%u.%u.%u.%u", p[0], p[1], p[2], p[3]);
-		}
-		else
-		{
-			struct in6_addr in_addr;
-			std::memcpy(in_addr.s6_addr, p, sizeof(in_addr.s6_addr));
-			inet_ntop(AF_INET6, in_addr.s6_addr, sz, sizeof(sz)-1);
-		}
+		static_assert(N > 1, "BUFFER TOO SHORT");
+		text::sink out{sz, N - 1};
+		if (this->size() > 2) { out.ip(this->data() + 2, this->size() - 2); }
+		sz[out.size()] = 0;
 	}
 
 };
@@ -84,6 +112,27 @@ This represents the number of seconds since 0h on 1 January 1900 with respect to
 */
 struct time : med::octet_string<med::octets_fix_intern<4>>
 {
+	using octet_string::set;
+
+	//NTP seconds
+	uint32_t get_ntp() const
+	{
+		auto const* p = this->data();
+		return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+	}
+	void set_ntp(uint32_t v)
+	{
+		uint8_t const be[4] = {uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v)};
+		set(sizeof(be), be);
+	}
+
+	//Unix seconds
+	int64_t get_unix() const            { return ntp_to_unix(get_ntp()); }
+	void set_unix(int64_t v)            { set_ntp(unix_to_ntp(v)); }
+
+	//current time by coarse_clock
+	void set_now()                      { set_ntp(coarse_clock::ntp()); }
+
 	static constexpr char const* name() { return "Time"; }
 };
 
@@ -209,7 +258,8 @@ struct session_id : avp<med::ascii_string<med::octets_var_intern<MAX_SESSION_ID_
 
 		if (fqdn && fqdn[0])
 		{
-			uint32_t const hiBits = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			//wall-clock seconds as high bits differ across restarts (RFC6733 8.8)
+			uint32_t const hiBits = coarse_clock::seconds();
 			char* out = (char*)body().emplace(MAX_SESSION_ID_LEN);
 			auto const len = (optional && optional[0])
 					? std::snprintf(out, MAX_SESSION_ID_LEN, "%s;%u;%u;%s", fqdn, hiBits, loBits, optional)
@@ -226,6 +276,10 @@ struct session_id : avp<med::ascii_string<med::octets_var_intern<MAX_SESSION_ID_
 		}
 	}
 
+	//copy of existing Session-Id (e.g. from request into answer)
+	template <class T, class Enable = std::enable_if_t<std::is_pointer_v<decltype(std::declval<T const>().data())>>>
+	auto set(T const& v)                { return body().set(v.size(), v.data()); }
+
 	static constexpr char const* name() { return "Session-Id"; }
 };
 
@@ -312,6 +366,10 @@ struct vendor_id : avp<enumerated<VENDOR>, 266, avp_flags::M>
 struct result_code : avp<enumerated<RESULT>, 268, avp_flags::M>
 {
 	bool is_accepted() const            { return RESULT::SUCCESS == body().get() || RESULT::LIMITED_SUCCESS == body().get(); }
+	bool is_protocol_error() const      { return diameter::is_protocol_error(body().get()); }
+	bool is_transient() const           { return diameter::is_transient(body().get()); }
+	bool is_permanent() const           { return diameter::is_permanent(body().get()); }
+	bool is_retriable() const           { return diameter::is_retriable(body().get()); }
 	static constexpr char const* name() { return "Result-Code"; }
 };
 
@@ -443,7 +501,7 @@ struct inband_security_id : avp<unsigned32, 299, avp_flags::M>
 
 
 //--------------- grouped ------------------//
-struct vendor_specific_application_id : avp_grouped<260, avp_flags::M, VENDOR::NONE
+struct vendor_specific_application_id : lazy_grouped<260, avp_flags::M, VENDOR::NONE
 	, M< vendor_id, med::inf >
 	, O< auth_application_id >
 	, O< acct_application_id >
@@ -457,7 +515,7 @@ struct failed_avp : avp<med::octet_string<>, 279, avp_flags::M>
 	static constexpr char const* name() { return "Failed-AVP"; }
 };
 
-struct proxy_info : avp_grouped<284, avp_flags::M, VENDOR::NONE
+struct proxy_info : lazy_grouped<284, avp_flags::M, VENDOR::NONE
 	, M< proxy_host >
 	, M< proxy_state >
 >
@@ -465,7 +523,7 @@ struct proxy_info : avp_grouped<284, avp_flags::M, VENDOR::NONE
 	static constexpr char const* name() { return "Proxy-Info"; }
 };
 
-struct experimental_result : avp_grouped<297, avp_flags::M, VENDOR::NONE
+struct experimental_result : lazy_grouped<297, avp_flags::M, VENDOR::NONE
 	, M< vendor_id >
 	, M< experimental_result_code >
 >
@@ -0,0 +1,154 @@
+#pragma once
+/**
+@file
+encode/decode of message choice (e.g. diameter::base) with the header done by header_view
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <type_traits>
+
+#include "med/encoder_context.hpp"
+#include "med/decoder_context.hpp"
+#include "med/octet_encoder.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/encode.hpp"
+#include "med/decode.hpp"
+
+#include "base.hpp"
+#include "scan.hpp"
+
+namespace diameter {
+
+namespace detail {
+
+template <class MSG, class = void>
+struct has_msg_code : std::false_type {};
+template <class MSG>
+struct has_msg_code<MSG, std::void_t<decltype(MSG::code)>> : std::true_type {};
+
+//tag of alternative of the choice or 0 if not a known message (e.g. any_request)
+template <class TAG, class MSG>
+constexpr uint32_t alt_tag()
+{
+	if constexpr (has_msg_code<MSG>::value)
+	{
+		using alt = med::mandatory<TAG, MSG>;
+		if constexpr (std::is_same_v<alt, request<MSG>>) { return REQUEST | MSG::code; }
+		else if constexpr (std::is_same_v<alt, answer<MSG>>) { return MSG::code; }
+	}
+	return 0;
+}
+
+//message of alternative selected by tag: header by header_view, AVPs by med
+template <class ALT> struct alt_codec
+{
+	template <class DIA>
+	static bool decode(DIA&, header_view const&, uint8_t const*, med::allocator&) { return false; }
+	template <class DIA>
+	static std::size_t encode(DIA&, uint32_t, uint8_t*, std::size_t)              { return 0; }
+};
+template <class TAG, class MSG> struct alt_codec<med::mandatory<TAG, MSG>>
+{
+	static constexpr uint32_t tag = alt_tag<TAG, MSG>();
+
+	template <class DIA>
+	static bool decode(DIA& dia, header_view const& hdr, uint8_t const* data, med::allocator& alloc)
+	{
+		if constexpr (tag != 0)
+		{
+			if (hdr.tag() != tag) { return false; }
+			dia.clear();
+			MSG& msg = dia.select();
+			auto& h = dia.header();
+			h.flags().set(hdr.flags);
+			h.ap_id(hdr.app_id);
+			h.hop_id(hdr.hop_id);
+			h.end_id(hdr.end_id);
+
+			med::decoder_context<med::allocator> ctx{data + header_view::SIZE, hdr.length - header_view::SIZE, &alloc};
+			med::decode(med::octet_decoder{ctx}, msg);
+			return true;
+		}
+		return false;
+	}
+
+	template <class DIA>
+	static std::size_t encode(DIA& dia, uint32_t msg_tag, uint8_t* out, std::size_t size)
+	{
+		if constexpr (tag != 0)
+		{
+			if (msg_tag != tag) { return 0; }
+			MSG const* msg = dia.cselect();
+			if (!msg) { return 0; }
+
+			med::encoder_context<> ctx{out + header_view::SIZE, size - header_view::SIZE};
+			med::encode(med::octet_encoder{ctx}, const_cast<MSG&>(*msg));
+
+			auto const& h = dia.header();
+			header_view const hdr{1, h.flags().get(), uint32_t(header_view::SIZE + ctx.buffer().get_offset())
+				, tag & 0xFFFFFF, h.ap_id(), h.hop_id(), h.end_id()};
+			hdr.encode(out);
+			return hdr.length;
+		}
+		return 0;
+	}
+};
+
+template <class DIA, class HDR, class... ALTS>
+bool decode_selected(DIA& dia, med::choice<HDR, ALTS...> const*, header_view const& hdr, uint8_t const* data, med::allocator& alloc)
+{
+	return (alt_codec<ALTS>::decode(dia, hdr, data, alloc) || ...);
+}
+
+template <class DIA, class HDR, class... ALTS>
+std::size_t encode_selected(DIA& dia, med::choice<HDR, ALTS...> const*, uint32_t tag, uint8_t* out, std::size_t size)
+{
+	std::size_t len = 0;
+	((len = alt_codec<ALTS>::encode(dia, tag, out, size)) || ...);
+	return len;
+}
+
+} //end: namespace detail
+
+/*
+Decodes message choice as med::decode but the header is parsed by header_view
+and med decodes only AVPs of the message selected by it. Header of a valid message
+(see header_view::parse) is expected: others and unknown messages are decoded by med.
+Throws med exceptions as med::decode.
+*/
+template <class DIA>
+void decode_message(DIA& dia, void const* data, std::size_t size, med::allocator& alloc)
+{
+	auto const* p = static_cast<uint8_t const*>(data);
+	header_view hdr;
+	if (!hdr.parse(p, size) || hdr.length > size
+		|| !detail::decode_selected(dia, &dia, hdr, p, alloc))
+	{
+		med::decoder_context<med::allocator> ctx{p, size, &alloc};
+		med::decode(med::octet_decoder{ctx}, dia);
+	}
+}
+
+/*
+Encodes message choice as med::encode but the header is written by header_view
+after med encoded AVPs of the selected message (unknown ones are encoded by med).
+Returns encoded size, throws med exceptions as med::encode.
+*/
+template <class DIA>
+std::size_t encode_message(DIA& dia, void* buf, std::size_t size)
+{
+	auto* out = static_cast<uint8_t*>(buf);
+	if (size >= header_view::SIZE)
+	{
+		if (auto const len = detail::encode_selected(dia, &dia, uint32_t(dia.header().get_tag()), out, size)) { return len; }
+	}
+	med::encoder_context<> ctx{out, size};
+	med::encode(med::octet_encoder{ctx}, dia);
+	return ctx.buffer().get_offset();
+}
+
+}	//end: namespace diameter
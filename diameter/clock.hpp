@@ -0,0 +1,122 @@
+#pragma once
+/**
+@file
+coarse shared clock and conversions between Unix and NTP (1900) time
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace diameter {
+
+//seconds from 1900-01-01 (NTP epoch) to 1970-01-01 (Unix epoch)
+constexpr uint32_t NTP_UNIX_OFFSET = 2208988800u;
+
+//NTP seconds (era wraps in 2036) from Unix seconds
+constexpr uint32_t unix_to_ntp(int64_t unix_sec)
+{
+	return uint32_t(unix_sec + NTP_UNIX_OFFSET);
+}
+
+//Unix seconds from NTP seconds: MSB clear means era 1, i.e. after 2036 (RFC4330 3)
+constexpr int64_t ntp_to_unix(uint32_t ntp_sec)
+{
+	return (ntp_sec & 0x80000000u)
+		? int64_t(ntp_sec) - NTP_UNIX_OFFSET
+		: int64_t(ntp_sec) + (int64_t(1) << 32) - NTP_UNIX_OFFSET;
+}
+
+/*
+Process-wide clock of coarse precision read by a relaxed load while it is kept
+fresh by coarse_clock::updater in background or by the caller ticking it (e.g. once
+per batch of messages) in coarse_clock::manual scope, otherwise the system clock is read.
+*/
+class coarse_clock
+{
+public:
+	//Unix time in ns
+	static uint64_t now()
+	{
+		return s_updaters.load(std::memory_order_acquire) ? s_ns.load(std::memory_order_relaxed) : system_ns();
+	}
+
+	//Unix time in seconds
+	static uint32_t seconds()               { return uint32_t(now() / 1000000000u); }
+	//NTP time in seconds
+	static uint32_t ntp()                   { return unix_to_ntp(int64_t(now() / 1000000000u)); }
+
+	//refreshes the time read while updater or manual scope is alive, returns the new time
+	static uint64_t tick()
+	{
+		uint64_t const ns = system_ns();
+		s_ns.store(ns, std::memory_order_relaxed);
+		return ns;
+	}
+
+	//background thread ticking with given period while alive
+	class updater
+	{
+	public:
+		explicit updater(std::chrono::milliseconds period = std::chrono::milliseconds{10})
+		{
+			//time is fresh once readers switch to it
+			tick();
+			s_updaters.fetch_add(1, std::memory_order_release);
+			m_thread = std::thread{[this, period]
+			{
+				while (!m_stop.load(std::memory_order_relaxed))
+				{
+					tick();
+					std::this_thread::sleep_for(period);
+				}
+			}};
+		}
+
+		~updater()
+		{
+			m_stop.store(true, std::memory_order_relaxed);
+			m_thread.join();
+			s_updaters.fetch_sub(1, std::memory_order_release);
+		}
+
+		updater(updater const&) = delete;
+		updater& operator=(updater const&) = delete;
+
+	private:
+		std::atomic<bool> m_stop{false};
+		std::thread       m_thread;
+	};
+
+	//time is refreshed only by tick() of the caller while alive
+	class manual
+	{
+	public:
+		manual()
+		{
+			tick();
+			s_updaters.fetch_add(1, std::memory_order_release);
+		}
+		~manual()                           { s_updaters.fetch_sub(1, std::memory_order_release); }
+
+		manual(manual const&) = delete;
+		manual& operator=(manual const&) = delete;
+	};
+
+private:
+	static uint64_t system_ns()
+	{
+		return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+	}
+
+	static inline std::atomic<uint64_t> s_ns{0};
+	static inline std::atomic<uint32_t> s_updaters{0}; //running updaters and manual scopes
+};
+
+}	//end: namespace diameter
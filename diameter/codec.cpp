@@ -0,0 +1,30 @@
+/**
+@file
+single instantiation of encode/decode of the message choices
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include "choice.hpp"
+#include "codec.hpp"
+
+namespace diameter::codec {
+
+std::size_t encode(base& dia, void* buf, std::size_t size)     { return encode_message(dia, buf, size); }
+std::size_t encode(cc::base& dia, void* buf, std::size_t size) { return encode_message(dia, buf, size); }
+
+void decode(base& dia, void const* data, std::size_t size, med::allocator& alloc)     { decode_message(dia, data, size, alloc); }
+void decode(cc::base& dia, void const* data, std::size_t size, med::allocator& alloc) { decode_message(dia, data, size, alloc); }
+
+decode_status try_decode(base& dia, void const* data, std::size_t size, med::allocator& alloc) noexcept
+{
+	return diameter::try_decode(dia, data, size, alloc);
+}
+decode_status try_decode(cc::base& dia, void const* data, std::size_t size, med::allocator& alloc) noexcept
+{
+	return diameter::try_decode(dia, data, size, alloc);
+}
+
+}	//end: namespace diameter::codec
@@ -0,0 +1,36 @@
+#pragma once
+/**
+@file
+non-template encode/decode of the message choices compiled once into libdiameter
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstddef>
+
+#include "base.hpp"
+#include "credit_control.hpp"
+#include "validate.hpp"
+
+/*
+The codec of a message choice is a deep tree of med templates instantiated
+in every translation unit calling med::encode/decode on it. Calling these
+instead keeps one copy of the code (see codec.cpp and `codesize` target).
+*/
+namespace diameter::codec {
+
+//encoded size, throws med exceptions as med::encode
+std::size_t encode(base& dia, void* buf, std::size_t size);
+std::size_t encode(cc::base& dia, void* buf, std::size_t size);
+
+//throws med exceptions as med::decode
+void decode(base& dia, void const* data, std::size_t size, med::allocator& alloc);
+void decode(cc::base& dia, void const* data, std::size_t size, med::allocator& alloc);
+
+//exception-free decode (see diameter::try_decode)
+decode_status try_decode(base& dia, void const* data, std::size_t size, med::allocator& alloc) noexcept;
+decode_status try_decode(cc::base& dia, void const* data, std::size_t size, med::allocator& alloc) noexcept;
+
+}	//end: namespace diameter::codec
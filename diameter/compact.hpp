@@ -0,0 +1,181 @@
+#pragma once
+/**
+@file
+compact storage of a message with many optional fields: only present AVPs take memory
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "scan.hpp"
+#include "traits.hpp"
+
+namespace diameter {
+
+/*
+Encoded message kept as presence bitmap of its fields plus packed slab of
+offsets of present fields followed by encoded AVPs. The slab is reused by next
+assign unless it needs to grow. The message type only defines the fields, e.g.
+	compact<diameter::ACR> acr;
+	if (acr.assign(data, size)) { if (auto v = acr.get<diameter::user_name>()) ... }
+*/
+template <class MSG>
+class compact
+{
+public:
+	using fields = detail::fields_of<MSG>;
+	static constexpr std::size_t count = std::tuple_size_v<fields>;
+	static_assert(count <= 64, "UP TO 64 FIELDS");
+
+	//false if not a valid message, all AVPs are kept but unknown ones are accessible only via any_avp of MSG
+	bool assign(void const* data, std::size_t size)
+	{
+		clear();
+		if (!m_header.parse(data, size) || m_header.length > size) { return false; }
+
+		//1st pass: presence and size of slab
+		uint8_t const* const avps = static_cast<uint8_t const*>(data) + header_view::SIZE;
+		std::size_t const avps_size = m_header.length - header_view::SIZE;
+		uint64_t present = 0;
+		uint16_t first[count];
+		{
+			avp_reader reader{avps, avps_size};
+			avp_view avp;
+			while (reader.next(avp))
+			{
+				std::size_t const i = index(avp.code, avp.vendor, std::make_index_sequence<count>{});
+				if (i < count && !(present & bit(i)))
+				{
+					present |= bit(i);
+					first[i] = uint16_t(avp.begin - avps);
+				}
+			}
+			if (reader.error() || avps_size > 0xFFFF) { return false; }
+		}
+
+		std::size_t const num = popcount(present);
+		std::size_t const slab_size = num * sizeof(uint16_t) + avps_size;
+		if (slab_size > m_capacity)
+		{
+			m_slab.reset(new uint8_t[slab_size]);
+			m_capacity = slab_size;
+		}
+		for (std::size_t i = 0, n = 0; i < count; ++i)
+		{
+			if (present & bit(i)) { std::memcpy(m_slab.get() + sizeof(uint16_t) * n++, &first[i], sizeof(uint16_t)); }
+		}
+		std::memcpy(m_slab.get() + num * sizeof(uint16_t), avps, avps_size);
+		m_present = present;
+		m_size = uint16_t(avps_size);
+		return true;
+	}
+
+	//keeps the slab for next assign
+	void clear()
+	{
+		m_present = 0;
+		m_size = 0;
+	}
+
+	header_view const& header() const       { return m_header; }
+
+	template <class FIELD>
+	bool has() const                        { return m_present & bit(index_of<FIELD>()); }
+
+	//first instance of encoded FIELD if present
+	template <class FIELD>
+	std::optional<avp_view> get() const
+	{
+		constexpr std::size_t i = index_of<FIELD>();
+		if (!(m_present & bit(i))) { return std::nullopt; }
+		avp_reader reader{avps() + offset(i), std::size_t(m_size - offset(i))};
+		avp_view avp;
+		if (reader.next(avp)) { return avp; }
+		return std::nullopt;
+	}
+
+	//calls func(avp_view const&) for each instance of FIELD
+	template <class FIELD, class FUNC>
+	void for_each(FUNC&& func) const
+	{
+		constexpr std::size_t i = index_of<FIELD>();
+		if (!(m_present & bit(i))) { return; }
+		avp_reader reader{avps() + offset(i), std::size_t(m_size - offset(i))};
+		avp_view avp;
+		while (reader.next(avp))
+		{
+			if (i == index(avp.code, avp.vendor, std::make_index_sequence<count>{})) { func(avp); }
+		}
+	}
+
+	//bytes used by present AVPs and their index
+	std::size_t footprint() const           { return sizeof(*this) + popcount(m_present) * sizeof(uint16_t) + m_size; }
+
+private:
+	static constexpr uint64_t bit(std::size_t i) { return uint64_t(1) << i; }
+	static std::size_t popcount(uint64_t v)      { return std::size_t(__builtin_popcountll(v)); }
+
+	template <std::size_t I>
+	static constexpr bool match(uint32_t code, uint32_t vendor)
+	{
+		using field = std::tuple_element_t<I, fields>;
+		if constexpr (detail::has_code<field>::value)
+		{
+			return code == field::id && vendor == static_cast<uint32_t>(field::vendor_value);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	//index of field for the AVP, unknown AVP goes to any_avp if present
+	template <std::size_t... I>
+	static constexpr std::size_t index(uint32_t code, uint32_t vendor, std::index_sequence<I...>)
+	{
+		std::size_t i = count;
+		((match<I>(code, vendor) ? (i = I, true) : false) || ...);
+		if (i == count) { ((!detail::has_code<std::tuple_element_t<I, fields>>::value ? (i = I, true) : false) || ...); }
+		return i;
+	}
+
+	template <class FIELD, std::size_t... I>
+	static constexpr std::size_t index_of(std::index_sequence<I...>)
+	{
+		std::size_t i = count;
+		((std::is_same_v<FIELD, std::tuple_element_t<I, fields>> ? (i = I, true) : false) || ...);
+		return i;
+	}
+
+	template <class FIELD>
+	static constexpr std::size_t index_of()
+	{
+		constexpr std::size_t i = index_of<FIELD>(std::make_index_sequence<count>{});
+		static_assert(i < count, "FIELD IS NOT IN THE MESSAGE");
+		return i;
+	}
+
+	uint8_t const* avps() const             { return m_slab.get() + popcount(m_present) * sizeof(uint16_t); }
+
+	std::size_t offset(std::size_t i) const
+	{
+		uint16_t v;
+		std::memcpy(&v, m_slab.get() + popcount(m_present & (bit(i) - 1)) * sizeof(uint16_t), sizeof(v));
+		return v;
+	}
+
+	header_view                m_header;
+	uint64_t                   m_present{0};
+	uint16_t                   m_size{0};
+	std::size_t                m_capacity{0}; //of slab
+	std::unique_ptr<uint8_t[]> m_slab;
+};
+
+}	//end: namespace diameter
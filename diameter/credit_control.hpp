@@ -0,0 +1,752 @@
+#pragma once
+/**
+@file
+RFC4006 Credit-Control application definition in med (https://github.com/cppden/med)
+
+Generated by tools/dict2hpp.py from dict/credit_control.dict - DO NOT EDIT.
+
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include "base.hpp"
+#include "enum_names.hpp"
+
+namespace diameter::cc {
+
+enum class CC_REQUEST_TYPE : uint32_t
+{
+	INITIAL_REQUEST     = 1,
+	UPDATE_REQUEST      = 2,
+	TERMINATION_REQUEST = 3,
+	EVENT_REQUEST       = 4,
+};
+
+enum class CC_SESSION_FAILOVER : uint32_t
+{
+	FAILOVER_NOT_SUPPORTED = 0,
+	FAILOVER_SUPPORTED     = 1,
+};
+
+enum class CC_UNIT_TYPE : uint32_t
+{
+	TIME                   = 0,
+	MONEY                  = 1,
+	TOTAL_OCTETS           = 2,
+	INPUT_OCTETS           = 3,
+	OUTPUT_OCTETS          = 4,
+	SERVICE_SPECIFIC_UNITS = 5,
+};
+
+enum class CHECK_BALANCE_RESULT : uint32_t
+{
+	ENOUGH_CREDIT = 0,
+	NO_CREDIT     = 1,
+};
+
+enum class CREDIT_CONTROL : uint32_t
+{
+	CREDIT_AUTHORIZATION = 0,
+	RE_AUTHORIZATION     = 1,
+};
+
+enum class CREDIT_CONTROL_FAILURE_HANDLING : uint32_t
+{
+	TERMINATE           = 0,
+	CONTINUE            = 1,
+	RETRY_AND_TERMINATE = 2,
+};
+
+enum class DIRECT_DEBITING_FAILURE_HANDLING : uint32_t
+{
+	TERMINATE_OR_BUFFER = 0,
+	CONTINUE            = 1,
+};
+
+enum class FINAL_UNIT_ACTION : uint32_t
+{
+	TERMINATE       = 0,
+	REDIRECT        = 1,
+	RESTRICT_ACCESS = 2,
+};
+
+enum class MULTIPLE_SERVICES_INDICATOR : uint32_t
+{
+	MULTIPLE_SERVICES_NOT_SUPPORTED = 0,
+	MULTIPLE_SERVICES_SUPPORTED     = 1,
+};
+
+enum class REDIRECT_ADDRESS_TYPE : uint32_t
+{
+	IPV4_ADDRESS = 0,
+	IPV6_ADDRESS = 1,
+	URL          = 2,
+	SIP_URI      = 3,
+};
+
+enum class REQUESTED_ACTION : uint32_t
+{
+	DIRECT_DEBITING = 0,
+	REFUND_ACCOUNT  = 1,
+	CHECK_BALANCE   = 2,
+	PRICE_ENQUIRY   = 3,
+};
+
+enum class SUBSCRIPTION_ID_TYPE : uint32_t
+{
+	END_USER_E164    = 0,
+	END_USER_IMSI    = 1,
+	END_USER_SIP_URI = 2,
+	END_USER_NAI     = 3,
+	END_USER_PRIVATE = 4,
+};
+
+enum class TARIFF_CHANGE_USAGE : uint32_t
+{
+	UNIT_BEFORE_TARIFF_CHANGE = 0,
+	UNIT_AFTER_TARIFF_CHANGE  = 1,
+	UNIT_INDETERMINATE        = 2,
+};
+
+enum class USER_EQUIPMENT_INFO_TYPE : uint32_t
+{
+	IMEISV         = 0,
+	MAC            = 1,
+	EUI64          = 2,
+	MODIFIED_EUI64 = 3,
+};
+
+struct filter_id : avp<med::ascii_string<>, 11, avp_flags::M>
+{
+	static constexpr char const* name() { return "Filter-Id"; }
+};
+
+struct cc_correlation_id : avp<med::octet_string<>, 411>
+{
+	static constexpr char const* name() { return "CC-Correlation-Id"; }
+};
+
+struct cc_input_octets : avp<unsigned64, 412, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Input-Octets"; }
+};
+
+struct cc_output_octets : avp<unsigned64, 414, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Output-Octets"; }
+};
+
+struct cc_request_number : avp<unsigned32, 415, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Request-Number"; }
+};
+
+struct cc_request_type : avp<enumerated<CC_REQUEST_TYPE>, 416, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Request-Type"; }
+};
+
+struct cc_service_specific_units : avp<unsigned64, 417, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Service-Specific-Units"; }
+};
+
+struct cc_session_failover : avp<enumerated<CC_SESSION_FAILOVER>, 418, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Session-Failover"; }
+};
+
+struct cc_sub_session_id : avp<unsigned64, 419, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Sub-Session-Id"; }
+};
+
+struct cc_time : avp<unsigned32, 420, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Time"; }
+};
+
+struct cc_total_octets : avp<unsigned64, 421, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Total-Octets"; }
+};
+
+struct check_balance_result : avp<enumerated<CHECK_BALANCE_RESULT>, 422, avp_flags::M>
+{
+	static constexpr char const* name() { return "Check-Balance-Result"; }
+};
+
+struct cost_unit : avp<med::ascii_string<>, 424, avp_flags::M>
+{
+	static constexpr char const* name() { return "Cost-Unit"; }
+};
+
+struct currency_code : avp<unsigned32, 425, avp_flags::M>
+{
+	static constexpr char const* name() { return "Currency-Code"; }
+};
+
+struct credit_control : avp<enumerated<CREDIT_CONTROL>, 426, avp_flags::M>
+{
+	static constexpr char const* name() { return "Credit-Control"; }
+};
+
+struct credit_control_failure_handling : avp<enumerated<CREDIT_CONTROL_FAILURE_HANDLING>, 427, avp_flags::M>
+{
+	static constexpr char const* name() { return "Credit-Control-Failure-Handling"; }
+};
+
+struct direct_debiting_failure_handling : avp<enumerated<DIRECT_DEBITING_FAILURE_HANDLING>, 428, avp_flags::M>
+{
+	static constexpr char const* name() { return "Direct-Debiting-Failure-Handling"; }
+};
+
+struct exponent : avp<integer32, 429, avp_flags::M>
+{
+	static constexpr char const* name() { return "Exponent"; }
+};
+
+struct rating_group : avp<unsigned32, 432, avp_flags::M>
+{
+	static constexpr char const* name() { return "Rating-Group"; }
+};
+
+struct redirect_address_type : avp<enumerated<REDIRECT_ADDRESS_TYPE>, 433, avp_flags::M>
+{
+	static constexpr char const* name() { return "Redirect-Address-Type"; }
+};
+
+struct redirect_server_address : avp<med::ascii_string<>, 435, avp_flags::M>
+{
+	static constexpr char const* name() { return "Redirect-Server-Address"; }
+};
+
+struct requested_action : avp<enumerated<REQUESTED_ACTION>, 436, avp_flags::M>
+{
+	static constexpr char const* name() { return "Requested-Action"; }
+};
+
+struct restriction_filter_rule : avp<med::octet_string<>, 438, avp_flags::M>
+{
+	static constexpr char const* name() { return "Restriction-Filter-Rule"; }
+};
+
+struct service_identifier : avp<unsigned32, 439, avp_flags::M>
+{
+	static constexpr char const* name() { return "Service-Identifier"; }
+};
+
+struct service_parameter_type : avp<unsigned32, 441, avp_flags::M>
+{
+	static constexpr char const* name() { return "Service-Parameter-Type"; }
+};
+
+struct service_parameter_value : avp<med::octet_string<>, 442, avp_flags::M>
+{
+	static constexpr char const* name() { return "Service-Parameter-Value"; }
+};
+
+struct subscription_id_data : avp<med::ascii_string<>, 444, avp_flags::M>
+{
+	static constexpr char const* name() { return "Subscription-Id-Data"; }
+};
+
+struct value_digits : avp<integer64, 447, avp_flags::M>
+{
+	static constexpr char const* name() { return "Value-Digits"; }
+};
+
+struct validity_time : avp<unsigned32, 448, avp_flags::M>
+{
+	static constexpr char const* name() { return "Validity-Time"; }
+};
+
+struct final_unit_action : avp<enumerated<FINAL_UNIT_ACTION>, 449, avp_flags::M>
+{
+	static constexpr char const* name() { return "Final-Unit-Action"; }
+};
+
+struct subscription_id_type : avp<enumerated<SUBSCRIPTION_ID_TYPE>, 450, avp_flags::M>
+{
+	static constexpr char const* name() { return "Subscription-Id-Type"; }
+};
+
+struct tariff_time_change : avp<time, 451, avp_flags::M>
+{
+	static constexpr char const* name() { return "Tariff-Time-Change"; }
+};
+
+struct tariff_change_usage : avp<enumerated<TARIFF_CHANGE_USAGE>, 452, avp_flags::M>
+{
+	static constexpr char const* name() { return "Tariff-Change-Usage"; }
+};
+
+struct g_s_u_pool_identifier : avp<unsigned32, 453, avp_flags::M>
+{
+	static constexpr char const* name() { return "G-S-U-Pool-Identifier"; }
+};
+
+struct cc_unit_type : avp<enumerated<CC_UNIT_TYPE>, 454, avp_flags::M>
+{
+	static constexpr char const* name() { return "CC-Unit-Type"; }
+};
+
+struct multiple_services_indicator : avp<enumerated<MULTIPLE_SERVICES_INDICATOR>, 455, avp_flags::M>
+{
+	static constexpr char const* name() { return "Multiple-Services-Indicator"; }
+};
+
+struct user_equipment_info_type : avp<enumerated<USER_EQUIPMENT_INFO_TYPE>, 459, avp_flags::M>
+{
+	static constexpr char const* name() { return "User-Equipment-Info-Type"; }
+};
+
+struct user_equipment_info_value : avp<med::octet_string<>, 460, avp_flags::M>
+{
+	static constexpr char const* name() { return "User-Equipment-Info-Value"; }
+};
+
+struct service_context_id : avp<med::ascii_string<>, 461, avp_flags::M>
+{
+	static constexpr char const* name() { return "Service-Context-Id"; }
+};
+
+struct unit_value : avp_grouped<445, avp_flags::M, VENDOR::NONE
+	, M< value_digits >
+	, O< exponent >
+>
+{
+	static constexpr char const* name() { return "Unit-Value"; }
+};
+
+struct cc_money : avp_grouped<413, avp_flags::M, VENDOR::NONE
+	, M< unit_value >
+	, O< currency_code >
+>
+{
+	static constexpr char const* name() { return "CC-Money"; }
+};
+
+struct cost_information : avp_grouped<423, avp_flags::M, VENDOR::NONE
+	, M< unit_value >
+	, M< currency_code >
+	, O< cost_unit >
+>
+{
+	static constexpr char const* name() { return "Cost-Information"; }
+};
+
+struct redirect_server : avp_grouped<434, avp_flags::M, VENDOR::NONE
+	, M< redirect_address_type >
+	, M< redirect_server_address >
+>
+{
+	static constexpr char const* name() { return "Redirect-Server"; }
+};
+
+struct final_unit_indication : avp_grouped<430, avp_flags::M, VENDOR::NONE
+	, M< final_unit_action >
+	, O< restriction_filter_rule, med::inf >
+	, O< filter_id, med::inf >
+	, O< redirect_server >
+>
+{
+	static constexpr char const* name() { return "Final-Unit-Indication"; }
+};
+
+struct granted_service_unit : avp_grouped<431, avp_flags::M, VENDOR::NONE
+	, O< tariff_time_change >
+	, O< cc_time >
+	, O< cc_money >
+	, O< cc_total_octets >
+	, O< cc_input_octets >
+	, O< cc_output_octets >
+	, O< cc_service_specific_units >
+	, O< any_avp, med::inf >
+>
+{
+	static constexpr char const* name() { return "Granted-Service-Unit"; }
+};
+
+struct requested_service_unit : avp_grouped<437, avp_flags::M, VENDOR::NONE
+	, O< cc_time >
+	, O< cc_money >
+	, O< cc_total_octets >
+	, O< cc_input_octets >
+	, O< cc_output_octets >
+	, O< cc_service_specific_units >
+	, O< any_avp, med::inf >
+>
+{
+	static constexpr char const* name() { return "Requested-Service-Unit"; }
+};
+
+struct used_service_unit : avp_grouped<446, avp_flags::M, VENDOR::NONE
+	, O< tariff_change_usage >
+	, O< cc_time >
+	, O< cc_money >
+	, O< cc_total_octets >
+	, O< cc_input_octets >
+	, O< cc_output_octets >
+	, O< cc_service_specific_units >
+	, O< any_avp, med::inf >
+>
+{
+	static constexpr char const* name() { return "Used-Service-Unit"; }
+};
+
+struct g_s_u_pool_reference : avp_grouped<457, avp_flags::M, VENDOR::NONE
+	, M< g_s_u_pool_identifier >
+	, M< cc_unit_type >
+	, M< unit_value >
+>
+{
+	static constexpr char const* name() { return "G-S-U-Pool-Reference"; }
+};
+
+struct multiple_services_credit_control : lazy_grouped<456, avp_flags::M, VENDOR::NONE
+	, O< granted_service_unit >
+	, O< requested_service_unit >
+	, O< used_service_unit, med::inf >
+	, O< tariff_change_usage >
+	, O< service_identifier, med::inf >
+	, O< rating_group >
+	, O< g_s_u_pool_reference, med::inf >
+	, O< validity_time >
+	, O< result_code >
+	, O< final_unit_indication >
+	, O< any_avp, med::inf >
+>
+{
+	static constexpr char const* name() { return "Multiple-Services-Credit-Control"; }
+};
+
+struct service_parameter_info : avp_grouped<440, 0, VENDOR::NONE
+	, M< service_parameter_type >
+	, M< service_parameter_value >
+>
+{
+	static constexpr char const* name() { return "Service-Parameter-Info"; }
+};
+
+struct subscription_id : avp_grouped<443, avp_flags::M, VENDOR::NONE
+	, M< subscription_id_type >
+	, M< subscription_id_data >
+>
+{
+	static constexpr char const* name() { return "Subscription-Id"; }
+};
+
+struct user_equipment_info : avp_grouped<458, 0, VENDOR::NONE
+	, M< user_equipment_info_type >
+	, M< user_equipment_info_value >
+>
+{
+	static constexpr char const* name() { return "User-Equipment-Info"; }
+};
+
+/*
+<CCR> ::= < Diameter Header: 272, REQ, PXY >
+	< Session-Id >
+	{ Origin-Host }
+	{ Origin-Realm }
+	{ Destination-Realm }
+	{ Auth-Application-Id }
+	{ Service-Context-Id }
+	{ CC-Request-Type }
+	{ CC-Request-Number }
+	[ Destination-Host ]
+	[ User-Name ]
+	[ CC-Sub-Session-Id ]
+	[ Acct-Multi-Session-Id ]
+	[ Origin-State-Id ]
+	[ Event-Timestamp ]
+	* [ Subscription-Id ]
+	[ Service-Identifier ]
+	[ Termination-Cause ]
+	[ Requested-Service-Unit ]
+	[ Requested-Action ]
+	* [ Used-Service-Unit ]
+	[ Multiple-Services-Indicator ]
+	* [ Multiple-Services-Credit-Control ]
+	* [ Service-Parameter-Info ]
+	[ CC-Correlation-Id ]
+	[ User-Equipment-Info ]
+	*MAX_PROXY_INFO [ Proxy-Info ]
+	*MAX_ROUTE_RECORD [ Route-Record ]
+	* [ AVP ]
+*/
+struct CCR : med::set<
+	M< session_id >,
+	M< origin_host >,
+	M< origin_realm >,
+	M< destination_realm >,
+	M< auth_application_id >,
+	M< service_context_id >,
+	M< cc_request_type >,
+	M< cc_request_number >,
+	O< destination_host >,
+	O< user_name >,
+	O< cc_sub_session_id >,
+	O< acct_multi_session_id >,
+	O< origin_state_id >,
+	O< event_timestamp >,
+	O< subscription_id, med::inf >,
+	O< service_identifier >,
+	O< termination_cause >,
+	O< requested_service_unit >,
+	O< requested_action >,
+	O< used_service_unit, med::inf >,
+	O< multiple_services_indicator >,
+	O< multiple_services_credit_control, med::inf >,
+	O< service_parameter_info, med::inf >,
+	O< cc_correlation_id >,
+	O< user_equipment_info >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
+	O< route_record, med::max<MAX_ROUTE_RECORD> >,
+	O< any_avp, med::inf >
+>
+{
+	static constexpr std::size_t code = 272;
+	static constexpr char const* name() { return "Credit-Control-Request"; }
+};
+
+/*
+<CCA> ::= < Diameter Header: 272, PXY >
+	< Session-Id >
+	{ Result-Code }
+	{ Origin-Host }
+	{ Origin-Realm }
+	{ Auth-Application-Id }
+	{ CC-Request-Type }
+	{ CC-Request-Number }
+	[ User-Name ]
+	[ CC-Session-Failover ]
+	[ CC-Sub-Session-Id ]
+	[ Acct-Multi-Session-Id ]
+	[ Origin-State-Id ]
+	[ Event-Timestamp ]
+	[ Granted-Service-Unit ]
+	* [ Multiple-Services-Credit-Control ]
+	[ Cost-Information ]
+	[ Final-Unit-Indication ]
+	[ Check-Balance-Result ]
+	[ Credit-Control-Failure-Handling ]
+	[ Direct-Debiting-Failure-Handling ]
+	[ Validity-Time ]
+	*MAX_REDIRECT_HOST [ Redirect-Host ]
+	[ Redirect-Host-Usage ]
+	[ Redirect-Max-Cache-Time ]
+	*MAX_PROXY_INFO [ Proxy-Info ]
+	*MAX_ROUTE_RECORD [ Route-Record ]
+	*MAX_FAILED_AVP [ Failed-AVP ]
+	* [ AVP ]
+*/
+struct CCA : med::set<
+	M< session_id >,
+	M< result_code >,
+	M< origin_host >,
+	M< origin_realm >,
+	M< auth_application_id >,
+	M< cc_request_type >,
+	M< cc_request_number >,
+	O< user_name >,
+	O< cc_session_failover >,
+	O< cc_sub_session_id >,
+	O< acct_multi_session_id >,
+	O< origin_state_id >,
+	O< event_timestamp >,
+	O< granted_service_unit >,
+	O< multiple_services_credit_control, med::inf >,
+	O< cost_information >,
+	O< final_unit_indication >,
+	O< check_balance_result >,
+	O< credit_control_failure_handling >,
+	O< direct_debiting_failure_handling >,
+	O< validity_time >,
+	O< redirect_host, med::max<MAX_REDIRECT_HOST> >,
+	O< redirect_host_usage >,
+	O< redirect_max_cache_time >,
+	O< proxy_info, med::max<MAX_PROXY_INFO> >,
+	O< route_record, med::max<MAX_ROUTE_RECORD> >,
+	O< failed_avp, med::max<MAX_FAILED_AVP> >,
+	O< any_avp, med::inf >
+>
+{
+	static constexpr std::size_t code = 272;
+	static constexpr char const* name() { return "Credit-Control-Answer"; }
+};
+
+struct base : med::choice< header
+	, request<CCR>
+	, answer<CCA>
+	, med::mandatory<any_request, Request>
+	, med::mandatory<any_answer, Answer>
+>
+{
+	using length_type = length;
+};
+
+}	//end: namespace diameter::cc
+
+namespace diameter {
+
+template <> struct enum_names<cc::CC_REQUEST_TYPE>
+{
+	using type = cc::CC_REQUEST_TYPE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::INITIAL_REQUEST, "INITIAL_REQUEST"},
+		{type::UPDATE_REQUEST, "UPDATE_REQUEST"},
+		{type::TERMINATION_REQUEST, "TERMINATION_REQUEST"},
+		{type::EVENT_REQUEST, "EVENT_REQUEST"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::CC_SESSION_FAILOVER>
+{
+	using type = cc::CC_SESSION_FAILOVER;
+	static constexpr enum_entry<type> entries[] = {
+		{type::FAILOVER_NOT_SUPPORTED, "FAILOVER_NOT_SUPPORTED"},
+		{type::FAILOVER_SUPPORTED, "FAILOVER_SUPPORTED"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::CC_UNIT_TYPE>
+{
+	using type = cc::CC_UNIT_TYPE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::TIME, "TIME"},
+		{type::MONEY, "MONEY"},
+		{type::TOTAL_OCTETS, "TOTAL_OCTETS"},
+		{type::INPUT_OCTETS, "INPUT_OCTETS"},
+		{type::OUTPUT_OCTETS, "OUTPUT_OCTETS"},
+		{type::SERVICE_SPECIFIC_UNITS, "SERVICE_SPECIFIC_UNITS"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::CHECK_BALANCE_RESULT>
+{
+	using type = cc::CHECK_BALANCE_RESULT;
+	static constexpr enum_entry<type> entries[] = {
+		{type::ENOUGH_CREDIT, "ENOUGH_CREDIT"},
+		{type::NO_CREDIT, "NO_CREDIT"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::CREDIT_CONTROL>
+{
+	using type = cc::CREDIT_CONTROL;
+	static constexpr enum_entry<type> entries[] = {
+		{type::CREDIT_AUTHORIZATION, "CREDIT_AUTHORIZATION"},
+		{type::RE_AUTHORIZATION, "RE_AUTHORIZATION"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::CREDIT_CONTROL_FAILURE_HANDLING>
+{
+	using type = cc::CREDIT_CONTROL_FAILURE_HANDLING;
+	static constexpr enum_entry<type> entries[] = {
+		{type::TERMINATE, "TERMINATE"},
+		{type::CONTINUE, "CONTINUE"},
+		{type::RETRY_AND_TERMINATE, "RETRY_AND_TERMINATE"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::DIRECT_DEBITING_FAILURE_HANDLING>
+{
+	using type = cc::DIRECT_DEBITING_FAILURE_HANDLING;
+	static constexpr enum_entry<type> entries[] = {
+		{type::TERMINATE_OR_BUFFER, "TERMINATE_OR_BUFFER"},
+		{type::CONTINUE, "CONTINUE"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::FINAL_UNIT_ACTION>
+{
+	using type = cc::FINAL_UNIT_ACTION;
+	static constexpr enum_entry<type> entries[] = {
+		{type::TERMINATE, "TERMINATE"},
+		{type::REDIRECT, "REDIRECT"},
+		{type::RESTRICT_ACCESS, "RESTRICT_ACCESS"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::MULTIPLE_SERVICES_INDICATOR>
+{
+	using type = cc::MULTIPLE_SERVICES_INDICATOR;
+	static constexpr enum_entry<type> entries[] = {
+		{type::MULTIPLE_SERVICES_NOT_SUPPORTED, "MULTIPLE_SERVICES_NOT_SUPPORTED"},
+		{type::MULTIPLE_SERVICES_SUPPORTED, "MULTIPLE_SERVICES_SUPPORTED"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::REDIRECT_ADDRESS_TYPE>
+{
+	using type = cc::REDIRECT_ADDRESS_TYPE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::IPV4_ADDRESS, "IPV4_ADDRESS"},
+		{type::IPV6_ADDRESS, "IPV6_ADDRESS"},
+		{type::URL, "URL"},
+		{type::SIP_URI, "SIP_URI"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::REQUESTED_ACTION>
+{
+	using type = cc::REQUESTED_ACTION;
+	static constexpr enum_entry<type> entries[] = {
+		{type::DIRECT_DEBITING, "DIRECT_DEBITING"},
+		{type::REFUND_ACCOUNT, "REFUND_ACCOUNT"},
+		{type::CHECK_BALANCE, "CHECK_BALANCE"},
+		{type::PRICE_ENQUIRY, "PRICE_ENQUIRY"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::SUBSCRIPTION_ID_TYPE>
+{
+	using type = cc::SUBSCRIPTION_ID_TYPE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::END_USER_E164, "END_USER_E164"},
+		{type::END_USER_IMSI, "END_USER_IMSI"},
+		{type::END_USER_SIP_URI, "END_USER_SIP_URI"},
+		{type::END_USER_NAI, "END_USER_NAI"},
+		{type::END_USER_PRIVATE, "END_USER_PRIVATE"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::TARIFF_CHANGE_USAGE>
+{
+	using type = cc::TARIFF_CHANGE_USAGE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::UNIT_BEFORE_TARIFF_CHANGE, "UNIT_BEFORE_TARIFF_CHANGE"},
+		{type::UNIT_AFTER_TARIFF_CHANGE, "UNIT_AFTER_TARIFF_CHANGE"},
+		{type::UNIT_INDETERMINATE, "UNIT_INDETERMINATE"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<cc::USER_EQUIPMENT_INFO_TYPE>
+{
+	using type = cc::USER_EQUIPMENT_INFO_TYPE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::IMEISV, "IMEISV"},
+		{type::MAC, "MAC"},
+		{type::EUI64, "EUI64"},
+		{type::MODIFIED_EUI64, "MODIFIED_EUI64"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+}	//end: namespace diameter
@@ -0,0 +1,77 @@
+#pragma once
+/**
+@file
+RFC7683 Diameter Overload Indication Conveyance definition in med (https://github.com/cppden/med)
+
+Generated by tools/dict2hpp.py from dict/doic.dict - DO NOT EDIT.
+
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include "base_avps.hpp"
+#include "enum_names.hpp"
+
+namespace diameter {
+
+enum class OC_REPORT_TYPE : uint32_t
+{
+	HOST_REPORT  = 0,
+	REALM_REPORT = 1,
+};
+
+struct oc_feature_vector : avp<unsigned64, 622>
+{
+	static constexpr char const* name() { return "OC-Feature-Vector"; }
+};
+
+struct oc_sequence_number : avp<unsigned64, 624>
+{
+	static constexpr char const* name() { return "OC-Sequence-Number"; }
+};
+
+struct oc_validity_duration : avp<unsigned32, 625>
+{
+	static constexpr char const* name() { return "OC-Validity-Duration"; }
+};
+
+struct oc_report_type : avp<enumerated<OC_REPORT_TYPE>, 626>
+{
+	static constexpr char const* name() { return "OC-Report-Type"; }
+};
+
+struct oc_reduction_percentage : avp<unsigned32, 627>
+{
+	static constexpr char const* name() { return "OC-Reduction-Percentage"; }
+};
+
+struct oc_supported_features : avp_grouped<621, 0, VENDOR::NONE
+	, O< oc_feature_vector >
+	, O< any_avp, med::inf >
+>
+{
+	static constexpr char const* name() { return "OC-Supported-Features"; }
+};
+
+struct oc_olr : avp_grouped<623, 0, VENDOR::NONE
+	, M< oc_sequence_number >
+	, M< oc_report_type >
+	, O< oc_reduction_percentage >
+	, O< oc_validity_duration >
+	, O< any_avp, med::inf >
+>
+{
+	static constexpr char const* name() { return "OC-OLR"; }
+};
+
+template <> struct enum_names<OC_REPORT_TYPE>
+{
+	using type = OC_REPORT_TYPE;
+	static constexpr enum_entry<type> entries[] = {
+		{type::HOST_REPORT, "HOST_REPORT"},
+		{type::REALM_REPORT, "REALM_REPORT"},
+	};
+	static constexpr enum_table table{entries};
+};
+
+}	//end: namespace diameter
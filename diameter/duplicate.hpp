@@ -0,0 +1,111 @@
+#pragma once
+/**
+@file
+RFC6733 5.5.4 duplicate detection of retransmitted requests (T-flag)
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace diameter {
+
+/*
+Requests seen within the time window keyed by (End-to-End Identifier, Origin-Host)
+with their encoded answers. Bounded: oldest entries are evicted first.
+Every request is recorded, so a retransmission (cmd_flags::retx) received after
+failover is answered from the cache instead of being processed again.
+Not thread-safe.
+*/
+class duplicate_cache
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	struct record
+	{
+		clock::time_point    received;
+		std::vector<uint8_t> answer; //empty while request is still processed
+	};
+
+	duplicate_cache(std::size_t capacity, std::chrono::seconds window)
+		: m_ring(capacity ? capacity : 1)
+		, m_window{window}
+	{
+		m_cache.reserve(m_ring.size());
+	}
+
+	/*
+	Registers the request and returns nullptr if it's new,
+	otherwise the record of the original request which is a duplicate of.
+	*/
+	record const* check(uint32_t end_id, std::string_view origin_host, clock::time_point now)
+	{
+		expire(now);
+		auto [it, inserted] = m_cache.try_emplace(make_key(end_id, origin_host), record{now, {}});
+		if (!inserted) { return &it->second; }
+
+		if (m_size == m_ring.size()) { pop(); }
+		m_ring[(m_head + m_size) % m_ring.size()] = &*it;
+		++m_size;
+		return nullptr;
+	}
+
+	//stores encoded answer to the request registered with check
+	bool answer(uint32_t end_id, std::string_view origin_host, void const* data, std::size_t size)
+	{
+		if (auto it = m_cache.find(make_key(end_id, origin_host)); it != m_cache.end())
+		{
+			auto const* p = static_cast<uint8_t const*>(data);
+			it->second.answer.assign(p, p + size);
+			return true;
+		}
+		return false;
+	}
+
+	//removes entries older than the window
+	void expire(clock::time_point now)
+	{
+		while (m_size && m_ring[m_head]->second.received + m_window <= now) { pop(); }
+	}
+
+	std::size_t size() const                { return m_size; }
+	std::size_t capacity() const            { return m_ring.size(); }
+
+private:
+	using map_t = std::unordered_map<std::string, record>;
+
+	void pop()
+	{
+		m_cache.erase(m_ring[m_head]->first);
+		m_head = (m_head + 1) % m_ring.size();
+		--m_size;
+	}
+
+	//End-to-End Identifier + Origin-Host; reuses the buffer to avoid allocation on lookup
+	std::string const& make_key(uint32_t end_id, std::string_view origin_host)
+	{
+		char id[sizeof(end_id)];
+		std::memcpy(id, &end_id, sizeof(id));
+		m_key.assign(id, sizeof(id));
+		m_key += origin_host;
+		return m_key;
+	}
+
+	map_t                           m_cache;
+	std::vector<map_t::value_type*> m_ring; //FIFO of entries in order of arrival
+	std::size_t                     m_head{0};
+	std::size_t                     m_size{0};
+	std::chrono::seconds            m_window;
+	std::string                     m_key;
+};
+
+}	//end: namespace diameter
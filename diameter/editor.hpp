@@ -0,0 +1,206 @@
+#pragma once
+/**
+@file
+copy-on-write editing of encoded message: untouched AVPs are copied as is
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "scan.hpp"
+#include "writer.hpp"
+
+namespace diameter {
+
+/*
+Edits of a message kept apart from its original encoded bytes (e.g. the buffer
+diameter::base was decoded from). Re-encode copies runs of untouched AVPs in bulk
+and writes only replaced and added ones, removed ones are skipped, e.g.
+	editor ed{data, size};
+	ed.set<diameter::destination_host>("hss2.example.net"sv);
+	ed.hop_id(next_hop_id);
+	auto const size = ed.encode(out, sizeof(out));
+Original bytes must stay valid until encode. Edits take no heap: number of them and
+size of their AVPs are limited by MAX_EDITS and PATCH_SIZE (see ok).
+*/
+class editor
+{
+public:
+	static constexpr std::size_t MAX_EDITS = 16;
+	static constexpr std::size_t PATCH_SIZE = 1024;
+	static_assert(MAX_EDITS <= 32, "BITMAP OF 32 EDITS");
+
+	//false if not a valid message
+	bool assign(void const* data, std::size_t size)
+	{
+		clear();
+		m_data = static_cast<uint8_t const*>(data);
+		if (!m_header.parse(data, size) || m_header.length > size) { m_data = nullptr; }
+		return m_data != nullptr;
+	}
+
+	editor() = default;
+	editor(void const* data, std::size_t size)  { assign(data, size); }
+	editor(editor const&) = delete;
+	editor& operator=(editor const&) = delete;
+
+	void clear()
+	{
+		m_data = nullptr;
+		m_count = 0;
+		m_patch = avp_writer{m_patch_buf, sizeof(m_patch_buf)};
+		m_failed = false;
+		m_hop_id = m_end_id = false;
+	}
+
+	header_view const& header() const       { return m_header; }
+	void hop_id(uint32_t v)                 { m_header.hop_id = v; m_hop_id = true; }
+	void end_id(uint32_t v)                 { m_header.end_id = v; m_end_id = true; }
+
+	//replaces instance of AVP (next one for each set of same AVP) or adds it if none (args as for avp_writer::add)
+	template <class AVP, class... ARGS>
+	void set(ARGS&&... args)
+	{
+		std::size_t const pos = m_patch.size();
+		m_patch.add<AVP>(std::forward<ARGS>(args)...);
+		push(REPLACE, AVP::id, static_cast<uint32_t>(AVP::vendor_value), pos);
+	}
+
+	//adds AVP after the original ones
+	template <class AVP, class... ARGS>
+	void add(ARGS&&... args)
+	{
+		std::size_t const pos = m_patch.size();
+		m_patch.add<AVP>(std::forward<ARGS>(args)...);
+		push(ADD, AVP::id, static_cast<uint32_t>(AVP::vendor_value), pos);
+	}
+
+	//encoded AVP (e.g. grouped one) to replace or add
+	void set(avp_view const& avp)
+	{
+		std::size_t const pos = m_patch.size();
+		m_patch.copy(avp);
+		push(REPLACE, avp.code, avp.vendor, pos);
+	}
+	void add(avp_view const& avp)
+	{
+		std::size_t const pos = m_patch.size();
+		m_patch.copy(avp);
+		push(ADD, avp.code, avp.vendor, pos);
+	}
+
+	//removes all instances of AVP
+	template <class AVP>
+	void remove()                           { push(REMOVE, AVP::id, static_cast<uint32_t>(AVP::vendor_value), m_patch.size()); }
+
+	//false if edits didn't fit
+	bool ok() const                         { return m_data && !m_failed && m_patch.ok(); }
+	bool modified() const                   { return m_count || m_hop_id || m_end_id; }
+
+	//edited message into buffer, its length or 0 if it didn't fit
+	std::size_t encode(void* buf, std::size_t size) const
+	{
+		if (!ok() || size < header_view::SIZE) { return 0; }
+		auto* const out = static_cast<uint8_t*>(buf);
+		uint8_t* pos = out + header_view::SIZE;
+		uint8_t* const end = out + size;
+		auto const put = [&](void const* data, std::size_t len)
+		{
+			if (std::size_t(end - pos) < len) { return false; }
+			std::memcpy(pos, data, len);
+			pos += len;
+			return true;
+		};
+
+		uint32_t replaced = 0; //bitmap of REPLACE edits done
+		uint8_t const* run = m_data + header_view::SIZE; //start of untouched AVPs
+		avp_reader reader{run, m_header.length - header_view::SIZE};
+		avp_view avp;
+		while (reader.next(avp))
+		{
+			std::size_t const i = find(avp, replaced);
+			if (i == m_count) { continue; }
+
+			if (!put(run, std::size_t(avp.begin - run))) { return 0; }
+			if (m_edits[i].op == REPLACE)
+			{
+				replaced |= (1u << i);
+				if (!put(patch(i), m_edits[i].length)) { return 0; }
+			}
+			run = reader.position();
+		}
+		if (reader.error()) { return 0; }
+		if (!put(run, std::size_t(m_data + m_header.length - run))) { return 0; }
+
+		//added and not found to replace
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			if (m_edits[i].op == ADD || (m_edits[i].op == REPLACE && !(replaced & (1u << i))))
+			{
+				if (!put(patch(i), m_edits[i].length)) { return 0; }
+			}
+		}
+
+		header_view hdr = m_header;
+		hdr.length = uint32_t(pos - out);
+		hdr.encode(out);
+		return hdr.length;
+	}
+
+private:
+	enum OP : uint8_t { REPLACE, ADD, REMOVE };
+
+	struct edit
+	{
+		uint32_t code;
+		uint32_t vendor;
+		uint16_t offset; //in patch
+		uint16_t length;
+		OP       op;
+	};
+
+	void push(OP op, uint32_t code, uint32_t vendor, std::size_t pos)
+	{
+		//nothing encoded for AVP to set or add (e.g. empty avp_view)
+		if (m_count == MAX_EDITS || !m_patch.ok() || (op != REMOVE && m_patch.size() == pos))
+		{
+			m_failed = true;
+			return;
+		}
+		m_edits[m_count++] = edit{code, vendor, uint16_t(pos), uint16_t(m_patch.size() - pos), op};
+	}
+
+	uint8_t const* patch(std::size_t i) const { return m_patch.data() + m_edits[i].offset; }
+
+	//edit of original AVP or m_count if none (each REPLACE applies to one instance)
+	std::size_t find(avp_view const& avp, uint32_t replaced) const
+	{
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			edit const& e = m_edits[i];
+			if (e.code == avp.code && e.vendor == avp.vendor && e.op != ADD
+				&& !(e.op == REPLACE && (replaced & (1u << i))))
+			{
+				return i;
+			}
+		}
+		return m_count;
+	}
+
+	uint8_t const* m_data{nullptr};
+	header_view    m_header{};
+	edit           m_edits[MAX_EDITS];
+	std::size_t    m_count{0};
+	uint8_t        m_patch_buf[PATCH_SIZE];
+	avp_writer     m_patch{m_patch_buf, sizeof(m_patch_buf)};
+	bool           m_failed{false};
+	bool           m_hop_id{false};
+	bool           m_end_id{false};
+};
+
+}	//end: namespace diameter
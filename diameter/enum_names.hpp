@@ -0,0 +1,255 @@
+#pragma once
+/**
+@file
+constexpr name <-> value tables of RESULT, EXPERIMENTAL_RESULT, APPLICATION and VENDOR
+(kept in sync by tools/enum_names.py, tables of dictionary enumerations are generated)
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "avp.hpp"
+#include "enums.hpp"
+
+namespace diameter {
+
+template <class E>
+struct enum_entry
+{
+	E                value;
+	std::string_view name;
+};
+
+/*
+Two copies of entries sorted at compile-time: by value and by name,
+both looked up by binary search. The first of duplicate values wins.
+*/
+template <class E, std::size_t N>
+class enum_table
+{
+public:
+	constexpr explicit enum_table(enum_entry<E> const (&entries)[N])
+	{
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			insert(m_by_value, i, entries[i], [](auto const& a, auto const& b) { return a.value < b.value; });
+			insert(m_by_name, i, entries[i], [](auto const& a, auto const& b) { return a.name < b.name; });
+		}
+	}
+
+	//name of value or empty if unknown
+	constexpr std::string_view name(E v) const
+	{
+		std::size_t lo = 0, hi = N;
+		while (lo < hi)
+		{
+			std::size_t const mid = (lo + hi) / 2;
+			if (m_by_value[mid].value < v) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+		return (lo < N && m_by_value[lo].value == v) ? m_by_value[lo].name : std::string_view{};
+	}
+
+	//value by exact name
+	constexpr std::optional<E> value(std::string_view s) const
+	{
+		std::size_t lo = 0, hi = N;
+		while (lo < hi)
+		{
+			std::size_t const mid = (lo + hi) / 2;
+			if (m_by_name[mid].name < s) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+		if (lo < N && m_by_name[lo].name == s) { return m_by_name[lo].value; }
+		return std::nullopt;
+	}
+
+	static constexpr std::size_t size()     { return N; }
+
+private:
+	//insertion sort (stable to keep the first of duplicates first)
+	template <class LESS>
+	static constexpr void insert(enum_entry<E> (&sorted)[N], std::size_t count, enum_entry<E> const& e, LESS less)
+	{
+		std::size_t i = count;
+		for (; i > 0 && less(e, sorted[i - 1]); --i) { sorted[i] = sorted[i - 1]; }
+		sorted[i] = e;
+	}
+
+	enum_entry<E> m_by_value[N] = {};
+	enum_entry<E> m_by_name[N] = {};
+};
+
+template <class E> struct enum_names;
+
+#define DIAMETER_ENUM_ENTRY(V) enum_entry<type>{type::V, #V}
+
+template <> struct enum_names<RESULT>
+{
+	using type = RESULT;
+	static constexpr enum_entry<type> entries[] = {
+		DIAMETER_ENUM_ENTRY(MULTI_ROUND_AUTH),
+		DIAMETER_ENUM_ENTRY(SUCCESS),
+		DIAMETER_ENUM_ENTRY(LIMITED_SUCCESS),
+		DIAMETER_ENUM_ENTRY(COMMAND_UNSUPPORTED),
+		DIAMETER_ENUM_ENTRY(UNABLE_TO_DELIVER),
+		DIAMETER_ENUM_ENTRY(REALM_NOT_SERVED),
+		DIAMETER_ENUM_ENTRY(TOO_BUSY),
+		DIAMETER_ENUM_ENTRY(LOOP_DETECTED),
+		DIAMETER_ENUM_ENTRY(REDIRECT_INDICATION),
+		DIAMETER_ENUM_ENTRY(APPLICATION_UNSUPPORTED),
+		DIAMETER_ENUM_ENTRY(INVALID_HDR_BITS),
+		DIAMETER_ENUM_ENTRY(INVALID_AVP_BITS),
+		DIAMETER_ENUM_ENTRY(UNKNOWN_PEER),
+		DIAMETER_ENUM_ENTRY(AUTHENTICATION_REJECTED),
+		DIAMETER_ENUM_ENTRY(OUT_OF_SPACE),
+		DIAMETER_ENUM_ENTRY(ELECTION_LOST),
+		DIAMETER_ENUM_ENTRY(AVP_UNSUPPORTED),
+		DIAMETER_ENUM_ENTRY(UNKNOWN_SESSION_ID),
+		DIAMETER_ENUM_ENTRY(AUTHORIZATION_REJECTED),
+		DIAMETER_ENUM_ENTRY(INVALID_AVP_VALUE),
+		DIAMETER_ENUM_ENTRY(MISSING_AVP),
+		DIAMETER_ENUM_ENTRY(RESOURCES_EXCEEDED),
+		DIAMETER_ENUM_ENTRY(CONTRADICTING_AVPS),
+		DIAMETER_ENUM_ENTRY(AVP_NOT_ALLOWED),
+		DIAMETER_ENUM_ENTRY(AVP_OCCURS_TOO_MANY_TIMES),
+		DIAMETER_ENUM_ENTRY(NO_COMMON_APPLICATION),
+		DIAMETER_ENUM_ENTRY(UNSUPPORTED_VERSION),
+		DIAMETER_ENUM_ENTRY(UNABLE_TO_COMPLY),
+		DIAMETER_ENUM_ENTRY(INVALID_BIT_IN_HEADER),
+		DIAMETER_ENUM_ENTRY(INVALID_AVP_LENGTH),
+		DIAMETER_ENUM_ENTRY(INVALID_MESSAGE_LENGTH),
+		DIAMETER_ENUM_ENTRY(INVALID_AVP_BIT_COMBO),
+		DIAMETER_ENUM_ENTRY(NO_COMMON_SECURITY),
+		DIAMETER_ENUM_ENTRY(DUPLICATED_AF_SESSION),
+		DIAMETER_ENUM_ENTRY(IP_CAN_SESSION_NOT_AVAILABLE),
+		DIAMETER_ENUM_ENTRY(ENCODE_FAILURE),
+		DIAMETER_ENUM_ENTRY(ENCODE_SUCCESS),
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<EXPERIMENTAL_RESULT>
+{
+	using type = EXPERIMENTAL_RESULT;
+	static constexpr enum_entry<type> entries[] = {
+		DIAMETER_ENUM_ENTRY(FIRST_REGISTRATION),
+		DIAMETER_ENUM_ENTRY(SUBSEQUENT_REGISTRATION),
+		DIAMETER_ENUM_ENTRY(UNREGISTERED_SERVICE),
+		DIAMETER_ENUM_ENTRY(SUCCESS_SERVER_NAME_NOT_STORED),
+		DIAMETER_ENUM_ENTRY(AUTHENTICATION_DATA_UNAVAILABLE),
+		DIAMETER_ENUM_ENTRY(ERROR_CAMEL_SUBSCRIPTION_PRESENT),
+		DIAMETER_ENUM_ENTRY(ERROR_USER_UNKNOWN),
+		DIAMETER_ENUM_ENTRY(ERROR_IDENTITIES_DONT_MATCH),
+		DIAMETER_ENUM_ENTRY(ERROR_IDENTITY_NOT_REGISTERED),
+		DIAMETER_ENUM_ENTRY(ERROR_ROAMING_NOT_ALLOWED),
+		DIAMETER_ENUM_ENTRY(ERROR_IDENTITY_ALREADY_REGISTERED),
+		DIAMETER_ENUM_ENTRY(ERROR_AUTH_SCHEME_NOT_SUPPORTED),
+		DIAMETER_ENUM_ENTRY(ERROR_IN_ASSIGNMENT_TYPE),
+		DIAMETER_ENUM_ENTRY(ERROR_TOO_MUCH_DATA),
+		DIAMETER_ENUM_ENTRY(ERROR_NOT_SUPPORTED_USER_DATA),
+		DIAMETER_ENUM_ENTRY(ERROR_FEATURE_UNSUPPORTED),
+		DIAMETER_ENUM_ENTRY(ERROR_SERVING_NODE_FEATURE_UNSUPPORTED),
+		DIAMETER_ENUM_ENTRY(ERROR_UNKNOWN_EPS_SUBSCRIPTION),
+		DIAMETER_ENUM_ENTRY(ERROR_RAT_NOT_ALLOWED),
+		DIAMETER_ENUM_ENTRY(ERROR_EQUIPMENT_UNKNOWN),
+		DIAMETER_ENUM_ENTRY(ERROR_UNKNOWN_SERVING_NODE),
+		DIAMETER_ENUM_ENTRY(ERROR_INVALID_SERVICE_INFORMATION),
+		DIAMETER_ENUM_ENTRY(ERROR_FILTER_RESTRICTIONS),
+		DIAMETER_ENUM_ENTRY(ERROR_REQUESTED_SERVICE_NOT_AUTHORIZED),
+		DIAMETER_ENUM_ENTRY(ERROR_DUPLICATED_AF_SESSION),
+		DIAMETER_ENUM_ENTRY(ERROR_IPCAN_SESSION_NOT_AVAILABLE),
+		DIAMETER_ENUM_ENTRY(ERROR_UNAUTHORIZED_NON_EMERGENCY_SESSION),
+		DIAMETER_ENUM_ENTRY(ERROR_UNAUTHORIZED_SPONSORED_DATA_CONNECTIVITY),
+		DIAMETER_ENUM_ENTRY(ERROR_TEMPORARY_NETWORK_FAILURE),
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<APPLICATION>
+{
+	using type = APPLICATION;
+	static constexpr enum_entry<type> entries[] = {
+		DIAMETER_ENUM_ENTRY(NONE),
+		DIAMETER_ENUM_ENTRY(DCCA),
+		DIAMETER_ENUM_ENTRY(CXDX),
+		DIAMETER_ENUM_ENTRY(SHPH),
+		DIAMETER_ENUM_ENTRY(RE),
+		DIAMETER_ENUM_ENTRY(WX),
+		DIAMETER_ENUM_ENTRY(ZN),
+		DIAMETER_ENUM_ENTRY(ZH),
+		DIAMETER_ENUM_ENTRY(GQ),
+		DIAMETER_ENUM_ENTRY(GMB),
+		DIAMETER_ENUM_ENTRY(GX_OVER_GY),
+		DIAMETER_ENUM_ENTRY(MM10),
+		DIAMETER_ENUM_ENTRY(PR),
+		DIAMETER_ENUM_ENTRY(RX),
+		DIAMETER_ENUM_ENTRY(GX),
+		DIAMETER_ENUM_ENTRY(STA),
+		DIAMETER_ENUM_ENTRY(S6A),
+		DIAMETER_ENUM_ENTRY(S13),
+		DIAMETER_ENUM_ENTRY(SLG),
+		DIAMETER_ENUM_ENTRY(SWM),
+		DIAMETER_ENUM_ENTRY(SWX),
+		DIAMETER_ENUM_ENTRY(GXX),
+		DIAMETER_ENUM_ENTRY(S9),
+		DIAMETER_ENUM_ENTRY(ZPN),
+		DIAMETER_ENUM_ENTRY(S6B),
+		DIAMETER_ENUM_ENTRY(SLH),
+		DIAMETER_ENUM_ENTRY(SGMB),
+		DIAMETER_ENUM_ENTRY(SY),
+		DIAMETER_ENUM_ENTRY(SD),
+		DIAMETER_ENUM_ENTRY(S7A),
+		DIAMETER_ENUM_ENTRY(TSP),
+		DIAMETER_ENUM_ENTRY(S6M),
+		DIAMETER_ENUM_ENTRY(T4),
+		DIAMETER_ENUM_ENTRY(S6C),
+		DIAMETER_ENUM_ENTRY(SGD),
+		DIAMETER_ENUM_ENTRY(S15),
+		DIAMETER_ENUM_ENTRY(S9A),
+		DIAMETER_ENUM_ENTRY(S9A_STAR),
+		DIAMETER_ENUM_ENTRY(MB2_C),
+		DIAMETER_ENUM_ENTRY(PC4A),
+		DIAMETER_ENUM_ENTRY(PC2),
+		DIAMETER_ENUM_ENTRY(PC6PC7),
+	};
+	static constexpr enum_table table{entries};
+};
+
+template <> struct enum_names<VENDOR>
+{
+	using type = VENDOR;
+	static constexpr enum_entry<type> entries[] = {
+		DIAMETER_ENUM_ENTRY(NONE),
+		DIAMETER_ENUM_ENTRY(HP),
+		DIAMETER_ENUM_ENTRY(SUN),
+		DIAMETER_ENUM_ENTRY(MERIT),
+		DIAMETER_ENUM_ENTRY(USR),
+		DIAMETER_ENUM_ENTRY(ERICSSON),
+		DIAMETER_ENUM_ENTRY(TGPP2),
+		DIAMETER_ENUM_ENTRY(TGPP),
+		DIAMETER_ENUM_ENTRY(VODAFONE),
+		DIAMETER_ENUM_ENTRY(ETSI),
+		DIAMETER_ENUM_ENTRY(NOKIA),
+		DIAMETER_ENUM_ENTRY(TGPPCXDX),
+		DIAMETER_ENUM_ENTRY(TGPPSH),
+	};
+	static constexpr enum_table table{entries};
+};
+
+#undef DIAMETER_ENUM_ENTRY
+
+//name of enumerator (e.g. "TOO_BUSY" for RESULT::TOO_BUSY) or empty if unknown
+template <class E>
+constexpr std::string_view enum_name(E v)               { return enum_names<E>::table.name(v); }
+
+//enumerator by its name
+template <class E>
+constexpr std::optional<E> enum_value(std::string_view s) { return enum_names<E>::table.value(s); }
+
+}	//end: namespace diameter
@@ -95,9 +95,30 @@ enum class EXPERIMENTAL_RESULT : uint32_t
 	ERROR_TEMPORARY_NETWORK_FAILURE                = 5068,
 };
 
+//class of result as per RFC6733 7.1: 1xxx informational, 2xxx success, 3xxx protocol error,
+//4xxx transient failure, 5xxx permanent failure
+template <class E>
+constexpr uint32_t result_class(E v)    { return static_cast<uint32_t>(v) / 1000; }
+
+constexpr bool is_informational(RESULT v)       { return result_class(v) == 1; }
+constexpr bool is_success(RESULT v)             { return result_class(v) == 2; }
+constexpr bool is_protocol_error(RESULT v)      { return result_class(v) == 3; }
+constexpr bool is_transient(RESULT v)           { return result_class(v) == 4; }
+constexpr bool is_permanent(RESULT v)           { return result_class(v) == 5; }
+//request may be retried, e.g. to another peer (RFC6733 6.1.8 and 7.1.3)
+constexpr bool is_retriable(RESULT v)
+{
+	return is_transient(v) || v == RESULT::UNABLE_TO_DELIVER || v == RESULT::TOO_BUSY;
+}
+
+constexpr bool is_success(EXPERIMENTAL_RESULT v)        { return result_class(v) == 2; }
+constexpr bool is_transient(EXPERIMENTAL_RESULT v)      { return result_class(v) == 4; }
+constexpr bool is_permanent(EXPERIMENTAL_RESULT v)      { return result_class(v) == 5; }
+
 enum class APPLICATION : uint32_t
 {
 	NONE       = 0,
+	DCCA       = 4, //RFC4006 Credit-Control
 	CXDX       = 16777216, //29.228 and 29.229
 	SHPH       = 16777217, //29.328 and 29.329
 	RE         = 16777218, //32.296
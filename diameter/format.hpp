@@ -0,0 +1,342 @@
+#pragma once
+/**
+@file
+formatting of decoded message into caller buffer as compact text or JSON
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "base.hpp"
+#include "text.hpp"
+#include "traits.hpp"
+#include "validate.hpp"
+
+namespace diameter {
+
+enum class FORMAT : uint8_t
+{
+	TEXT, //Name(code) flags app hop end: AVP=value AVP={AVP=value}
+	JSON, //{"message":Name,...,"avps":{"AVP":value,"AVP":[value,value]}}
+};
+
+/*
+Visits all fields of the selected message, AVP names are from their name()
+*/
+class formatter
+{
+public:
+	//words of allocator to decode AVPs of not expanded lazy grouped AVP
+	static constexpr std::size_t LAZY_ALLOC = 256;
+
+	formatter(char* buf, std::size_t size, FORMAT fmt)
+		: m_out{buf, size}, m_json{fmt == FORMAT::JSON}
+	{}
+
+	//message of choice like diameter::base
+	template <class HDR, class... ALTS>
+	void message(med::choice<HDR, ALTS...> const& dia)
+	{
+		(alternative(dia, static_cast<ALTS const*>(nullptr)) || ...);
+	}
+
+	std::string_view str() const            { return m_out.str(); }
+	bool truncated() const                  { return m_out.truncated(); }
+
+private:
+	template <class DIA, class TAG, class MSG>
+	bool alternative(DIA const& dia, med::mandatory<TAG, MSG> const*)
+	{
+		MSG const* msg = dia.cselect();
+		if (!msg) { return false; }
+
+		auto const& hdr = dia.header();
+		char flags[5];
+		hdr.flags().print(flags);
+		uint32_t const code = uint32_t(hdr.get_tag() & ~REQUEST);
+		if (m_json)
+		{
+			m_out.put("{\"message\":\"");
+			m_out.put(MSG::name());
+			m_out.put("\",\"code\":");
+			m_out.number(code);
+			m_out.put(",\"flags\":\"");
+			m_out.put(flags);
+			m_out.put("\",\"app\":");
+			m_out.number(hdr.ap_id());
+			m_out.put(",\"hop\":");
+			m_out.number(hdr.hop_id());
+			m_out.put(",\"end\":");
+			m_out.number(hdr.end_id());
+			m_out.put(",\"avps\":{");
+			fields<MSG>(*msg);
+			m_out.put("}}");
+		}
+		else
+		{
+			m_out.put(MSG::name());
+			m_out.put('(');
+			m_out.number(code);
+			m_out.put(") ");
+			m_out.put(flags);
+			m_out.put(" app=");
+			m_out.number(hdr.ap_id());
+			m_out.put(" hop=");
+			m_out.hex32(hdr.hop_id());
+			m_out.put(" end=");
+			m_out.hex32(hdr.end_id());
+			m_out.put(':');
+			fields<MSG>(*msg);
+		}
+		return true;
+	}
+
+	template <class SET, class T>
+	void fields(T const& s)
+	{
+		using traits = detail::traits_of<SET>;
+		bool first = true;
+		std::apply([&](auto... f) { (field<typename decltype(f)::type, decltype(f)::mandatory, decltype(f)::single>(s, first), ...); }
+			, traits{});
+	}
+
+	template <class FIELD, bool MANDATORY, bool SINGLE, class T>
+	void field(T const& s, bool& first)
+	{
+		if constexpr (!SINGLE)
+		{
+			auto const& list = s.template get<FIELD>();
+			if (list.begin() == list.end()) { return; }
+			if (m_json)
+			{
+				key<FIELD>(first);
+				m_out.put('[');
+				bool next = false;
+				for (auto const& v : list)
+				{
+					if (next) { m_out.put(','); }
+					next = true;
+					value(v);
+				}
+				m_out.put(']');
+			}
+			else
+			{
+				for (auto const& v : list)
+				{
+					key<FIELD>(first);
+					value(v);
+				}
+			}
+		}
+		else if constexpr (MANDATORY)
+		{
+			auto const& v = s.template get<FIELD>();
+			if (!v.is_set()) { return; }
+			key<FIELD>(first);
+			value(v);
+		}
+		else
+		{
+			if (auto const* v = s.template get<FIELD>())
+			{
+				key<FIELD>(first);
+				value(*v);
+			}
+		}
+	}
+
+	template <class FIELD>
+	void key(bool& first)
+	{
+		std::string_view name = "AVP";
+		if constexpr (detail::has_code<FIELD>::value) { name = FIELD::name(); }
+
+		if (m_json)
+		{
+			if (!first) { m_out.put(','); }
+			m_out.put('"');
+			m_out.put(name);
+			m_out.put("\":");
+		}
+		else
+		{
+			m_out.put(' ');
+			m_out.put(name);
+			m_out.put('=');
+		}
+		first = false;
+	}
+
+	void string(void const* data, std::size_t size)
+	{
+		if (text::printable(data, size))
+		{
+			m_out.put('"');
+			auto const* p = static_cast<char const*>(data);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				if (p[i] == '"' || p[i] == '\\') { m_out.put('\\'); }
+				m_out.put(p[i]);
+			}
+			m_out.put('"');
+		}
+		else
+		{
+			if (m_json) { m_out.put('"'); }
+			m_out.hex(data, size);
+			if (m_json) { m_out.put('"'); }
+		}
+	}
+
+	template <class AVP>
+	void value(AVP const& v)
+	{
+		if constexpr (!detail::has_code<AVP>::value) //any_avp
+		{
+			auto const& data = v.template get<med::octet_string<>>();
+			m_out.put(m_json ? "{\"code\":" : "{code=");
+			m_out.number(v.template get<avp_code>().get());
+			if (auto const* vnd = v.template get<vendor>())
+			{
+				m_out.put(m_json ? ",\"vendor\":" : " vendor=");
+				m_out.number(vnd->get());
+			}
+			m_out.put(m_json ? ",\"data\":" : " data=");
+			string(data.data(), data.size());
+			m_out.put('}');
+		}
+		else if constexpr (detail::is_grouped<AVP>::value)
+		{
+			if constexpr (detail::is_lazy<AVP>::value)
+			{
+				//not expanded AVPs are decoded into a copy, printed as encoded if invalid
+				if (auto const* raw = v.octets(); raw && !v.expanded())
+				{
+					std::size_t alloc_buf[LAZY_ALLOC];
+					med::allocator alloc{alloc_buf};
+					AVP copy = v;
+					if (copy.expand(alloc))
+					{
+						value(copy);
+					}
+					else
+					{
+						if (m_json) { m_out.put('"'); }
+						m_out.hex(raw->data(), raw->size());
+						if (m_json) { m_out.put('"'); }
+					}
+					return;
+				}
+			}
+			m_out.put('{');
+			fields<typename AVP::set_type>(v);
+			if (!m_json) { m_out.put(' '); }
+			m_out.put('}');
+		}
+		else
+		{
+			using value_type = detail::avp_value_t<AVP>;
+			if constexpr (std::is_base_of_v<address, value_type>)
+			{
+				if (m_json) { m_out.put('"'); }
+				if (v.size() > 2) { m_out.ip(v.data() + 2, v.size() - 2); }
+				if (m_json) { m_out.put('"'); }
+			}
+			else if constexpr (std::is_same_v<time, value_type>)
+			{
+				auto const* p = v.data();
+				m_out.number((uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]);
+			}
+			else if constexpr (std::is_same_v<med::IE_VALUE, typename value_type::ie_type>)
+			{
+				auto const x = v.get();
+				if constexpr (std::is_enum_v<decltype(x)>) { m_out.number(static_cast<std::underlying_type_t<decltype(x)>>(x)); }
+				else if constexpr (std::is_same_v<integer32, value_type>) { m_out.number(int32_t(x)); }
+				else if constexpr (std::is_same_v<integer64, value_type>) { m_out.number(int64_t(x)); }
+				else { m_out.number(x); }
+			}
+			else
+			{
+				string(v.data(), v.size());
+			}
+		}
+	}
+
+	text::sink m_out;
+	bool       m_json;
+};
+
+namespace detail {
+
+template <class ALT> struct alternative_name
+{
+	static char const* get(uint32_t)        { return nullptr; }
+};
+template <class TAG, class MSG> struct alternative_name<med::mandatory<TAG, MSG>>
+{
+	static char const* get(uint32_t tag)
+	{
+		if constexpr (has_msg_code<MSG>::value)
+		{
+			using alt = med::mandatory<TAG, MSG>;
+			if constexpr (std::is_same_v<alt, request<MSG>> || std::is_same_v<alt, answer<MSG>>)
+			{
+				constexpr uint32_t expected = std::is_same_v<alt, request<MSG>> ? (REQUEST | MSG::code) : MSG::code;
+				if (tag == expected) { return MSG::name(); }
+			}
+		}
+		return nullptr;
+	}
+};
+
+template <class HDR, class... ALTS>
+char const* choice_name(med::choice<HDR, ALTS...> const*, uint32_t tag)
+{
+	char const* name = nullptr;
+	((name = alternative_name<ALTS>::get(tag)) || ...);
+	return name;
+}
+
+} //end: namespace detail
+
+//name of message by its tag (code | REQUEST bit), e.g. for metrics::dump
+template <class DIA = base>
+char const* message_name(uint32_t tag)
+{
+	if (char const* name = detail::choice_name(static_cast<DIA const*>(nullptr), tag)) { return name; }
+	return (tag & REQUEST) ? Request::name() : Answer::name();
+}
+
+//formatted message in the buffer (truncated if it doesn't fit)
+template <class DIA>
+std::string_view format(DIA const& dia, char* buf, std::size_t size, FORMAT fmt = FORMAT::TEXT)
+{
+	formatter f{buf, size, fmt};
+	f.message(dia);
+	return f.str();
+}
+
+//decodes and formats raw frame (e.g. from trace_ring), one failed to decode as hex
+template <class DIA = base>
+std::string_view format_frame(void const* data, std::size_t size, char* buf, std::size_t buf_size, FORMAT fmt = FORMAT::TEXT)
+{
+	std::size_t alloc_buf[256];
+	med::allocator alloc{alloc_buf};
+	DIA dia;
+	if (try_decode(dia, data, size, alloc)) { return format(dia, buf, buf_size, fmt); }
+
+	text::sink out{buf, buf_size};
+	if (fmt == FORMAT::JSON) { out.put("{\"frame\":\""); }
+	out.hex(data, size);
+	if (fmt == FORMAT::JSON) { out.put("\"}"); }
+	return out.str();
+}
+
+}	//end: namespace diameter
@@ -0,0 +1,130 @@
+#pragma once
+/**
+@file
+compact fixed-layout IP address and list of them (e.g. Host-IP-Address of peers)
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <netinet/in.h>
+
+#include "text.hpp"
+
+namespace diameter {
+
+/*
+IPv4 or IPv6 address in network order w/o the family octets of Address AVP,
+comparable by a couple of word loads (IPv4 is kept zero-extended).
+*/
+struct ip_address
+{
+	uint8_t bytes[16] = {};
+	uint8_t length{0}; //4, 16 or 0 if not set
+
+	ip_address() = default;
+	ip_address(void const* data, std::size_t size)
+	{
+		if (size == 4 || size == 16)
+		{
+			std::memcpy(bytes, data, size);
+			length = uint8_t(size);
+		}
+	}
+	explicit ip_address(in_addr const& v)   : ip_address{&v, sizeof(v)} {}
+	explicit ip_address(in6_addr const& v)  : ip_address{&v, sizeof(v)} {}
+
+	//from text, empty if it's invalid
+	static ip_address parse(std::string_view s)
+	{
+		ip_address ip;
+		ip.length = uint8_t(text::parse_ip(s, ip.bytes));
+		if (!ip.length) { std::memset(ip.bytes, 0, sizeof(ip.bytes)); }
+		return ip;
+	}
+
+	bool is_v4() const                      { return length == 4; }
+	bool is_v6() const                      { return length == 16; }
+	bool empty() const                      { return length == 0; }
+	uint8_t const* data() const             { return bytes; }
+	std::size_t size() const                { return length; }
+
+	bool get(in_addr& v) const
+	{
+		if (!is_v4()) { return false; }
+		std::memcpy(&v, bytes, sizeof(v));
+		return true;
+	}
+	bool get(in6_addr& v) const
+	{
+		if (!is_v6()) { return false; }
+		std::memcpy(&v, bytes, sizeof(v));
+		return true;
+	}
+
+	//text into the buffer (truncated if it doesn't fit)
+	std::string_view print(char* buf, std::size_t size) const
+	{
+		text::sink out{buf, size};
+		out.ip(bytes, length);
+		return out.str();
+	}
+
+	friend bool operator==(ip_address const& lhs, ip_address const& rhs)
+	{
+		return lhs.length == rhs.length && 0 == std::memcmp(lhs.bytes, rhs.bytes, sizeof(lhs.bytes));
+	}
+	friend bool operator!=(ip_address const& lhs, ip_address const& rhs) { return !(lhs == rhs); }
+};
+
+/*
+Fixed capacity list of addresses w/o allocations, e.g. peer addresses from CER/CEA
+for ACL checks. Addresses above capacity are ignored.
+*/
+template <std::size_t N>
+class ip_address_list
+{
+public:
+	//false if the list is full or address is empty
+	bool add(ip_address const& ip)
+	{
+		if (m_count == N || ip.empty()) { return false; }
+		m_list[m_count++] = ip;
+		return true;
+	}
+
+	//from Host-IP-Address AVPs of a message, e.g. ip_address_list<8>::from(cer.get<host_ip_address>())
+	template <class RANGE>
+	static ip_address_list from(RANGE const& avps)
+	{
+		ip_address_list list;
+		for (auto const& avp : avps) { list.add(avp.ip()); }
+		return list;
+	}
+
+	bool contains(ip_address const& ip) const
+	{
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			if (m_list[i] == ip) { return true; }
+		}
+		return false;
+	}
+
+	void clear()                            { m_count = 0; }
+	std::size_t size() const                { return m_count; }
+	static constexpr std::size_t capacity() { return N; }
+	ip_address const* begin() const         { return m_list; }
+	ip_address const* end() const           { return m_list + m_count; }
+
+private:
+	ip_address  m_list[N];
+	std::size_t m_count{0};
+};
+
+}	//end: namespace diameter
@@ -0,0 +1,183 @@
+#pragma once
+/**
+@file
+Grouped AVP with on demand decoding of its AVPs
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <utility>
+
+#include "med/decoder_context.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/decode.hpp"
+
+#include "avp.hpp"
+
+namespace diameter {
+
+namespace detail {
+
+//encoded AVPs of grouped AVP: always decoded, encoded unless the AVPs were modified
+struct lazy_octets : med::octet_string<>
+{
+	static constexpr char const* name()     { return "Encoded-AVPs"; }
+
+	struct has
+	{
+		template <class T>
+		bool operator()(T const&) const     { return true; }
+	};
+};
+
+//AVPs of grouped AVP: decoded on expand, encoded only if modified
+template <class SET>
+struct lazy_fields : SET
+{
+	struct has
+	{
+		template <class T>
+		bool operator()(T const&) const     { return false; }
+	};
+
+	bool is_set() const                     { return modified && SET::is_set(); }
+
+	bool expanded{false};
+	bool modified{false};
+};
+
+//allocator of decoder context or nullptr if none
+template <class DECODER>
+auto allocator_of(DECODER& decoder, int) -> decltype(&decoder.get_allocator())
+{
+	return &decoder.get_allocator();
+}
+template <class DECODER>
+med::allocator* allocator_of(DECODER&, ...)   { return nullptr; }
+
+/*
+Body of grouped AVP: the outer decode only records the encoded AVPs (points to the
+decoded buffer as any other non-copied octets) and the allocator of its context.
+The AVPs are decoded into SET on first access (or explicit expand).
+Unless modified the body is encoded back as is, otherwise SET is encoded.
+NOTE: the decoded buffer and allocator shall outlive the body.
+*/
+template <class SET>
+struct lazy_body : med::sequence<
+		O< lazy_octets, lazy_octets::has >,
+		O< lazy_fields<SET>, typename lazy_fields<SET>::has >
+	>
+{
+	using base_t = med::sequence<
+		O< lazy_octets, lazy_octets::has >,
+		O< lazy_fields<SET>, typename lazy_fields<SET>::has >
+	>;
+	using fields_type = lazy_fields<SET>;
+
+	template <class DECODER, class... ARGS>
+	void decode(DECODER& decoder, ARGS&&... args)
+	{
+		base_t::decode(decoder, std::forward<ARGS>(args)...);
+		m_alloc = allocator_of(decoder, 0);
+	}
+
+	bool is_set() const
+	{
+		return fields_ref().modified ? fields_ref().is_set() : (this->template get<lazy_octets>() != nullptr);
+	}
+
+	void clear()
+	{
+		this->template ref<lazy_octets>().clear();
+		fields_type& f = this->template ref<fields_type>();
+		f.clear();
+		f.expanded = f.modified = false;
+		m_alloc = nullptr;
+	}
+
+	lazy_octets const* octets() const       { return fields_ref().modified ? nullptr : this->template get<lazy_octets>(); }
+
+	bool expand(med::allocator& alloc) const
+	{
+		//decoded AVPs are a cache of the encoded ones
+		fields_type& f = fields_ref();
+		if (f.expanded || f.modified) { return true; }
+		if (auto const* raw = this->template get<lazy_octets>())
+		{
+			try
+			{
+				med::decoder_context<med::allocator> ctx{raw->data(), raw->size(), &alloc};
+				med::decode(med::octet_decoder{ctx}, static_cast<SET&>(f));
+			}
+			catch (...)
+			{
+				f.clear();
+				return false;
+			}
+		}
+		f.expanded = true;
+		return true;
+	}
+
+	//AVPs decoded with allocator of the outer decode, empty if invalid
+	SET const& fields() const
+	{
+		if (m_alloc && !expand(*m_alloc)) { const_cast<lazy_body*>(this)->m_alloc = nullptr; }
+		return fields_ref();
+	}
+
+	//encoded AVPs are dropped once decoded (invalid ones are lost)
+	SET& modify()
+	{
+		fields();
+		this->template ref<lazy_octets>().clear();
+		fields_type& f = this->template ref<fields_type>();
+		f.modified = true;
+		return f;
+	}
+
+	bool expanded() const                   { return fields_ref().expanded; }
+
+private:
+	fields_type& fields_ref() const         { return const_cast<lazy_body*>(this)->template ref<fields_type>(); }
+
+	med::allocator* m_alloc{nullptr};
+};
+
+} //end: namespace detail
+
+/***************************************************************
+ * Grouped AVP decoded on first access to its AVPs, e.g.
+ *	for (auto const& pi : msg.get<proxy_info>())
+ *	{
+ *		auto const* host = pi.get<proxy_host>(); //decoded here
+ *	}
+ * AVPs are decoded with the allocator of the message decode, invalid ones
+ * give no AVPs (expand tells it) and are not re-encoded if modified.
+ ***************************************************************/
+template <avp_code::value_type CODE, uint8_t FLAGS, VENDOR VND, class... AVPs>
+struct lazy_grouped : detail::avp_header< detail::lazy_body<med::set<AVPs...>>, CODE, FLAGS, VND >
+{
+	static_assert(sizeof...(AVPs) > 1, "USE PLAIN AVP FOR SINGLE VALUE");
+
+	using set_type = med::set<AVPs...>;
+
+	//decodes AVPs with multi-instance ones in given allocator, false if invalid
+	bool expand(med::allocator& alloc) const { return this->body().expand(alloc); }
+	bool expanded() const                   { return this->body().expanded(); }
+
+	//encoded AVPs as decoded or nullptr if modified
+	detail::lazy_octets const* octets() const { return this->body().octets(); }
+
+	template <class FIELD>
+	decltype(auto) ref()                    { return this->body().modify().template ref<FIELD>(); }
+	template <class FIELD>
+	decltype(auto) get() const              { return this->body().fields().template get<FIELD>(); }
+
+	template <class FIELD>
+	std::size_t count() const               { return this->body().fields().template count<FIELD>(); }
+};
+
+}	//end: namespace diameter
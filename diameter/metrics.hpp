@@ -0,0 +1,274 @@
+#pragma once
+/**
+@file
+per-command counters and latency histograms sharded per thread
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "text.hpp"
+
+namespace diameter {
+
+namespace detail {
+
+//single writer increment w/o atomic read-modify-write (readers may see stale value)
+inline void bump(std::atomic<uint64_t>& v, uint64_t n = 1) { v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+
+} //end: namespace detail
+
+/*
+HDR-style log-linear histogram: 16 sub-buckets per power of 2 (~6% precision)
+for values up to 2^36 (e.g. ns up to ~68s), larger ones go to the last bucket.
+*/
+class histogram
+{
+public:
+	static constexpr unsigned SUB_BITS = 4;
+	static constexpr unsigned SUB = 1u << SUB_BITS;
+	static constexpr unsigned MAX_BITS = 36;
+	static constexpr unsigned BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB;
+
+	static constexpr unsigned index(uint64_t v)
+	{
+		if (v < SUB) { return unsigned(v); }
+		unsigned const shift = 63 - unsigned(__builtin_clzll(v)) - SUB_BITS;
+		unsigned const idx = (shift + 1) * SUB + unsigned((v >> shift) & (SUB - 1));
+		return idx < BUCKETS ? idx : BUCKETS - 1;
+	}
+
+	//lowest value of bucket
+	static constexpr uint64_t value(unsigned idx)
+	{
+		if (idx < SUB) { return idx; }
+		return uint64_t(SUB + idx % SUB) << (idx / SUB - 1);
+	}
+
+	void record(uint64_t v)
+	{
+		detail::bump(m_counts[index(v)]);
+		detail::bump(m_count);
+		detail::bump(m_sum, v);
+	}
+
+	void merge(histogram const& other)
+	{
+		for (unsigned i = 0; i < BUCKETS; ++i) { detail::bump(m_counts[i], other.m_counts[i].load(std::memory_order_relaxed)); }
+		detail::bump(m_count, other.m_count.load(std::memory_order_relaxed));
+		detail::bump(m_sum, other.m_sum.load(std::memory_order_relaxed));
+	}
+
+	//lowest value of the bucket containing the quantile q=[0..1]
+	uint64_t quantile(double q) const
+	{
+		uint64_t const total = count();
+		if (0 == total) { return 0; }
+		uint64_t const rank = uint64_t(q * double(total - 1)) + 1;
+		uint64_t acc = 0;
+		for (unsigned i = 0; i < BUCKETS; ++i)
+		{
+			acc += m_counts[i].load(std::memory_order_relaxed);
+			if (acc >= rank) { return value(i); }
+		}
+		return value(BUCKETS - 1);
+	}
+
+	uint64_t count() const                  { return m_count.load(std::memory_order_relaxed); }
+	uint64_t sum() const                    { return m_sum.load(std::memory_order_relaxed); }
+
+private:
+	//64-bit as merged and long-running counts overflow 32 bits
+	std::atomic<uint64_t> m_counts[BUCKETS] = {};
+	std::atomic<uint64_t> m_count{0};
+	std::atomic<uint64_t> m_sum{0};
+};
+
+enum class STAGE : uint8_t
+{
+	DECODE,
+	ENCODE,
+	HANDLE,
+};
+
+//metrics of one command (tag = code | REQUEST bit) of application
+struct alignas(64) command_metrics
+{
+	static constexpr uint64_t EMPTY = ~uint64_t(0);
+
+	std::atomic<uint64_t> key{EMPTY}; //app << 32 | tag
+	std::atomic<uint64_t> messages{0};
+	std::atomic<uint64_t> bytes{0};
+	std::atomic<uint64_t> decode_failures{0};
+	histogram             latency[3];
+
+	void count(std::size_t size)                { detail::bump(messages); detail::bump(bytes, size); }
+	void decode_failed()                        { detail::bump(decode_failures); }
+	void record(STAGE stage, uint64_t ns)       { latency[std::size_t(stage)].record(ns); }
+};
+
+/*
+Per-thread metrics and their aggregation, e.g.
+	auto& shard = stats.add_shard(); //once in worker thread
+	auto& cmd = shard.at(hdr.tag(), hdr.app_id);
+	cmd.count(size);
+	cmd.record(STAGE::DECODE, ns);
+*/
+class metrics
+{
+public:
+	static constexpr std::size_t MAX_COMMANDS = 64;
+
+	//counters of one thread: written only by the owner, read by dump
+	class shard
+	{
+	public:
+		//metrics of the command, the last one collects all which don't fit
+		command_metrics& at(uint32_t tag, uint32_t app)
+		{
+			uint64_t const key = (uint64_t(app) << 32) | tag;
+			std::size_t i = std::size_t((key * 0x9E3779B97F4A7C15ULL) >> 58) % (MAX_COMMANDS - 1);
+			for (std::size_t n = 0; n < MAX_COMMANDS - 1; ++n, i = (i + 1) % (MAX_COMMANDS - 1))
+			{
+				uint64_t const k = m_commands[i].key.load(std::memory_order_relaxed);
+				if (k == key) { return m_commands[i]; }
+				if (k == command_metrics::EMPTY)
+				{
+					m_commands[i].key.store(key, std::memory_order_release);
+					return m_commands[i];
+				}
+			}
+			return m_commands[MAX_COMMANDS - 1];
+		}
+
+	private:
+		friend class metrics;
+		command_metrics m_commands[MAX_COMMANDS];
+	};
+
+	//one per worker thread, lives as long as metrics
+	shard& add_shard()
+	{
+		std::lock_guard lock{m_mutex};
+		return m_shards.emplace_back();
+	}
+
+	/*
+	Text exposition of all shards aggregated, NAMER: char const*(uint32_t tag),
+	e.g. message_name<diameter::base> (see format.hpp)
+	*/
+	template <class NAMER>
+	std::string dump(NAMER&& namer) const
+	{
+		struct total
+		{
+			uint64_t  messages{0}, bytes{0}, decode_failures{0};
+			histogram latency[3];
+		};
+		std::map<uint64_t, total> totals;
+		{
+			std::lock_guard lock{m_mutex};
+			for (auto const& s : m_shards)
+			{
+				for (std::size_t i = 0; i < MAX_COMMANDS; ++i)
+				{
+					auto const& c = s.m_commands[i];
+					uint64_t const key = c.key.load(std::memory_order_acquire);
+					if (key == command_metrics::EMPTY)
+					{
+						if (i != MAX_COMMANDS - 1 || 0 == c.messages.load(std::memory_order_relaxed)) { continue; }
+					}
+					auto& t = totals[key];
+					t.messages += c.messages.load(std::memory_order_relaxed);
+					t.bytes += c.bytes.load(std::memory_order_relaxed);
+					t.decode_failures += c.decode_failures.load(std::memory_order_relaxed);
+					for (std::size_t l = 0; l < 3; ++l) { t.latency[l].merge(c.latency[l]); }
+				}
+			}
+		}
+
+		std::string out;
+		char line[256];
+		//metric{command="name",app="id"[,stage="stage"] w/o closing brace
+		auto const labels = [&](text::sink& s, char const* metric, uint64_t key, char const* stage)
+		{
+			s.put(metric);
+			s.put("{command=\"");
+			if (key == command_metrics::EMPTY) { s.put("other"); }
+			else
+			{
+				char const* name = namer(uint32_t(key));
+				if (name) { s.put(name); }
+				else { s.number(uint32_t(key) & 0xFFFFFF); }
+			}
+			s.put("\",app=\"");
+			if (key != command_metrics::EMPTY) { s.number(uint32_t(key >> 32)); }
+			s.put('"');
+			if (stage)
+			{
+				s.put(",stage=\"");
+				s.put(stage);
+				s.put('"');
+			}
+		};
+		auto const sample = [&](text::sink& s, uint64_t v)
+		{
+			s.put("} ");
+			s.number(v);
+			s.put('\n');
+			out += s.str();
+		};
+		auto const counter = [&](char const* metric, uint64_t key, char const* stage, uint64_t v)
+		{
+			text::sink s{line, sizeof(line)};
+			labels(s, metric, key, stage);
+			sample(s, v);
+		};
+
+		out += "# TYPE diameter_messages_total counter\n";
+		for (auto const& [key, t] : totals) { counter("diameter_messages_total", key, nullptr, t.messages); }
+		out += "# TYPE diameter_bytes_total counter\n";
+		for (auto const& [key, t] : totals) { counter("diameter_bytes_total", key, nullptr, t.bytes); }
+		out += "# TYPE diameter_decode_failures_total counter\n";
+		for (auto const& [key, t] : totals) { counter("diameter_decode_failures_total", key, nullptr, t.decode_failures); }
+
+		static constexpr char const* stages[] = {"decode", "encode", "handle"};
+		static constexpr double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+		static constexpr char const* qnames[] = {"0.5", "0.9", "0.99", "0.999"};
+		out += "# TYPE diameter_latency_ns summary\n";
+		for (auto const& [key, t] : totals)
+		{
+			for (std::size_t l = 0; l < 3; ++l)
+			{
+				auto const& h = t.latency[l];
+				if (0 == h.count()) { continue; }
+				for (std::size_t q = 0; q < 4; ++q)
+				{
+					text::sink s{line, sizeof(line)};
+					labels(s, "diameter_latency_ns", key, stages[l]);
+					s.put(",quantile=\"");
+					s.put(qnames[q]);
+					s.put('"');
+					sample(s, h.quantile(quantiles[q]));
+				}
+				counter("diameter_latency_ns_sum", key, stages[l], h.sum());
+				counter("diameter_latency_ns_count", key, stages[l], h.count());
+			}
+		}
+		return out;
+	}
+
+private:
+	mutable std::mutex m_mutex;
+	std::deque<shard>  m_shards;
+};
+
+}	//end: namespace diameter
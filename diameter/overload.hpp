@@ -0,0 +1,173 @@
+#pragma once
+/**
+@file
+RFC7683 DOIC reacting node: throttling of requests towards overloaded nodes
+with the loss algorithm (OLR_DEFAULT_ALGO)
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "doic.hpp"
+
+namespace diameter {
+
+//OC-Feature-Vector bits
+enum OC_FEATURE : uint64_t
+{
+	OLR_DEFAULT_ALGO = 0x0000000000000001,
+};
+
+namespace detail {
+
+//per-thread xorshift32 returning [0, 100)
+inline uint32_t percent_sample()
+{
+	thread_local uint32_t s = 0x9E3779B9u ^ uint32_t(reinterpret_cast<uintptr_t>(&s));
+	s ^= s << 13;
+	s ^= s >> 17;
+	s ^= s << 5;
+	return uint32_t((uint64_t(s) * 100) >> 32);
+}
+
+} //end: namespace detail
+
+/*
+Overload report (OC-OLR) received for a host or realm and application.
+Updated from answers and checked on the send path without locks.
+*/
+class overload_state
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr std::chrono::seconds DEFAULT_VALIDITY{30};
+	static constexpr std::chrono::seconds MAX_VALIDITY{86400};
+
+	//applies the report if its sequence number is newer, validity 0 ends the overload
+	bool update(uint64_t sequence, uint32_t reduction, std::chrono::seconds validity, clock::time_point now)
+	{
+		uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+		do
+		{
+			if (m_valid && sequence <= seq) { return false; }
+		}
+		while (!m_sequence.compare_exchange_weak(seq, sequence, std::memory_order_relaxed));
+		m_valid = true;
+
+		if (validity > MAX_VALIDITY) { validity = MAX_VALIDITY; }
+		m_reduction.store(reduction > 100 ? 100 : reduction, std::memory_order_relaxed);
+		m_expires.store((now + validity).time_since_epoch().count(), std::memory_order_release);
+		return true;
+	}
+
+	//from received OC-OLR AVP
+	template <class OLR>
+	bool update(OLR const& olr, clock::time_point now)
+	{
+		auto const* reduction = olr.template get<oc_reduction_percentage>();
+		auto const* validity = olr.template get<oc_validity_duration>();
+		return update(olr.template get<oc_sequence_number>().get()
+			, reduction ? reduction->get() : 0
+			, validity ? std::chrono::seconds{validity->get()} : DEFAULT_VALIDITY
+			, now);
+	}
+
+	//current reduction percentage (0 if not overloaded)
+	uint32_t reduction(clock::time_point now) const
+	{
+		if (now.time_since_epoch().count() >= m_expires.load(std::memory_order_acquire)) { return 0; }
+		return m_reduction.load(std::memory_order_relaxed);
+	}
+
+	//false if request is to be throttled
+	bool admit(clock::time_point now) const
+	{
+		uint32_t const pct = reduction(now);
+		return pct == 0 || detail::percent_sample() >= pct;
+	}
+
+private:
+	std::atomic<uint64_t>   m_sequence{0};
+	std::atomic<uint32_t>   m_reduction{0};
+	std::atomic<clock::rep> m_expires{0};
+	std::atomic<bool>       m_valid{false};
+};
+
+/*
+Reports of all overloaded nodes: host reports apply to requests with Destination-Host,
+realm reports to requests routed by Destination-Realm only.
+Throttled requests are to be answered locally with RESULT::TOO_BUSY.
+Readers look up an immutable map published on each new node (as route_table).
+*/
+class overload_control
+{
+public:
+	using clock = overload_state::clock;
+
+	//state of host or realm for the application, created if not present
+	overload_state& state(OC_REPORT_TYPE type, std::string_view name, uint32_t app)
+	{
+		std::lock_guard lock{m_mutex};
+		auto const& key = make_key(m_key, type, name, app);
+		auto states = std::atomic_load(&m_states);
+		if (states)
+		{
+			if (auto it = states->find(key); it != states->end()) { return *it->second; }
+		}
+
+		//new node is rare: copy of the map is published for readers
+		auto next = states ? std::make_shared<state_map>(*states) : std::make_shared<state_map>();
+		auto& p = (*next)[key];
+		p = std::make_shared<overload_state>();
+		std::atomic_store(&m_states, std::shared_ptr<state_map const>{std::move(next)});
+		m_count.fetch_add(1, std::memory_order_release);
+		return *p;
+	}
+
+	//false if request is to be throttled; host may be empty
+	bool admit(std::string_view host, std::string_view realm, uint32_t app, clock::time_point now) const
+	{
+		//no reports ever received
+		if (0 == m_count.load(std::memory_order_acquire)) { return true; }
+
+		thread_local std::string key;
+		auto const states = std::atomic_load(&m_states);
+		auto it = states->find(host.empty()
+			? make_key(key, OC_REPORT_TYPE::REALM_REPORT, realm, app)
+			: make_key(key, OC_REPORT_TYPE::HOST_REPORT, host, app));
+		return it != states->end() ? it->second->admit(now) : true;
+	}
+
+private:
+	//states are shared by all published maps
+	using state_map = std::unordered_map<std::string, std::shared_ptr<overload_state>>;
+
+	static std::string const& make_key(std::string& key, OC_REPORT_TYPE type, std::string_view name, uint32_t app)
+	{
+		char buf[1 + sizeof(app)];
+		buf[0] = char(type);
+		std::memcpy(buf + 1, &app, sizeof(app));
+		key.assign(buf, sizeof(buf));
+		key += name;
+		return key;
+	}
+
+	std::mutex                       m_mutex; //of writers
+	std::shared_ptr<state_map const> m_states;
+	std::atomic<std::size_t>         m_count{0};
+	std::string                      m_key;
+};
+
+}	//end: namespace diameter
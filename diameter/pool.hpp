@@ -0,0 +1,70 @@
+#pragma once
+/**
+@file
+pool of reusable message objects (e.g. diameter::base) constructed once
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstddef>
+#include <memory>
+
+namespace diameter {
+
+/*
+Fixed number of MSG objects allocated and constructed once. Released object is
+reset with clear() which in med resets the presence of the fields (only the
+selected alternative in choice) instead of constructing the whole object again, e.g.
+	pool<diameter::base, 64> msgs;
+	if (auto dia = msgs.acquire()) { decode(med::octet_decoder{ctx}, *dia); ... }
+Not thread-safe: one pool per worker thread. Handles must not outlive the pool.
+*/
+template <class MSG, std::size_t N>
+class pool
+{
+public:
+	static_assert(N > 0, "EMPTY POOL");
+
+	struct deleter
+	{
+		pool* owner;
+		void operator()(MSG* p) const   { owner->release(p); }
+	};
+	using handle = std::unique_ptr<MSG, deleter>;
+
+	pool()
+		: m_objects{new MSG[N]}
+	{
+		for (std::size_t i = 0; i < N; ++i) { m_free[i] = N - 1 - i; }
+	}
+
+	pool(pool const&) = delete;
+	pool& operator=(pool const&) = delete;
+
+	//empty handle if all objects are in use
+	handle acquire()
+	{
+		if (0 == m_top) { return handle{nullptr, deleter{this}}; }
+		return handle{&m_objects[m_free[--m_top]], deleter{this}};
+	}
+
+	static void reset(MSG& msg)             { msg.clear(); }
+
+	std::size_t available() const           { return m_top; }
+	static constexpr std::size_t capacity() { return N; }
+
+private:
+	void release(MSG* p)
+	{
+		reset(*p);
+		m_free[m_top++] = std::size_t(p - m_objects.get());
+	}
+
+	std::unique_ptr<MSG[]> m_objects;
+	std::size_t            m_free[N];   //stack of free indexes
+	std::size_t            m_top{N};
+};
+
+}	//end: namespace diameter
@@ -0,0 +1,171 @@
+#pragma once
+/**
+@file
+RFC6733 6.13 cache of redirect indications (Redirect-Host-Usage, Redirect-Max-Cache-Time)
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "base_avps.hpp"
+
+namespace diameter {
+
+/*
+Routes subsequent requests directly to the redirected host(s).
+Entries are keyed by the scope selected with Redirect-Host-Usage and expire after
+Redirect-Max-Cache-Time. Lookup is one hash probe per scope which has any entries.
+Not thread-safe.
+*/
+class redirect_cache
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	//request attributes the cached scopes are matched on
+	struct request_key
+	{
+		std::string_view session;  //Session-Id
+		std::string_view realm;    //Destination-Realm
+		std::string_view host;     //Destination-Host
+		std::string_view user;     //User-Name
+		uint32_t         app;      //Application-Id
+	};
+
+	using hosts = std::vector<std::string>;
+
+	//caches hosts for the scope of usage (DONT_CACHE or scope missing in request are ignored)
+	void add(REDIRECT_HOST_USAGE usage, request_key const& req, hosts redirect, std::chrono::seconds max_cache_time, clock::time_point now)
+	{
+		if (usage == REDIRECT_HOST_USAGE::DONT_CACHE || !valid(usage) || redirect.empty() || !has_scope(usage, req)) { return; }
+		auto const expires = now + max_cache_time;
+		auto [it, inserted] = m_cache.try_emplace(make_key(usage, req), entry{std::move(redirect), expires});
+		if (inserted) { ++m_count[std::size_t(usage)]; }
+		else { it->second = entry{std::move(redirect), expires}; }
+	}
+
+	//caches redirect indication from RAA, STA, ASA etc.
+	template <class ANSWER>
+	bool add(ANSWER const& ans, request_key const& req, clock::time_point now)
+	{
+		auto const* usage = ans.template get<redirect_host_usage>();
+		auto const* cache_time = ans.template get<redirect_max_cache_time>();
+		if (!usage || !cache_time) { return false; }
+
+		hosts redirect;
+		for (auto const& h : ans.template get<redirect_host>())
+		{
+			redirect.emplace_back(reinterpret_cast<char const*>(h.data()), h.size());
+		}
+		if (redirect.empty()) { return false; }
+		add(usage->get(), req, std::move(redirect), std::chrono::seconds{cache_time->get()}, now);
+		return true;
+	}
+
+	//cached hosts or nullptr, most specific scope first as per RFC6733 6.13
+	hosts const* find(request_key const& req, clock::time_point now)
+	{
+		for (auto usage : {
+			REDIRECT_HOST_USAGE::ALL_SESSION,
+			REDIRECT_HOST_USAGE::ALL_USER,
+			REDIRECT_HOST_USAGE::REALM_AND_APPLICATION,
+			REDIRECT_HOST_USAGE::ALL_REALM,
+			REDIRECT_HOST_USAGE::ALL_APPLICATION,
+			REDIRECT_HOST_USAGE::ALL_HOST })
+		{
+			if (0 == m_count[std::size_t(usage)] || !has_scope(usage, req)) { continue; }
+			if (auto it = m_cache.find(make_key(usage, req)); it != m_cache.end())
+			{
+				if (it->second.expires > now) { return &it->second.redirect; }
+				erase(it);
+			}
+		}
+		return nullptr;
+	}
+
+	//removes all expired entries
+	void purge(clock::time_point now)
+	{
+		for (auto it = m_cache.begin(); it != m_cache.end(); )
+		{
+			if (it->second.expires <= now) { it = erase(it); }
+			else { ++it; }
+		}
+	}
+
+	std::size_t size() const                { return m_cache.size(); }
+	void clear()                            { m_cache.clear(); for (auto& c : m_count) { c = 0; } }
+
+private:
+	struct entry
+	{
+		hosts             redirect;
+		clock::time_point expires;
+	};
+	using map_t = std::unordered_map<std::string, entry>;
+
+	static constexpr std::size_t NUM_USAGES = std::size_t(REDIRECT_HOST_USAGE::ALL_USER) + 1;
+
+	static bool valid(REDIRECT_HOST_USAGE usage) { return std::size_t(usage) < NUM_USAGES; }
+
+	map_t::iterator erase(map_t::iterator it)
+	{
+		--m_count[std::size_t(it->first[0])];
+		return m_cache.erase(it);
+	}
+
+	//request has the attribute of the usage scope (empty one is missing)
+	static bool has_scope(REDIRECT_HOST_USAGE usage, request_key const& req)
+	{
+		switch (usage)
+		{
+		case REDIRECT_HOST_USAGE::ALL_SESSION:     return !req.session.empty();
+		case REDIRECT_HOST_USAGE::ALL_HOST:        return !req.host.empty();
+		case REDIRECT_HOST_USAGE::ALL_USER:        return !req.user.empty();
+		case REDIRECT_HOST_USAGE::ALL_REALM:
+		case REDIRECT_HOST_USAGE::REALM_AND_APPLICATION:
+			return !req.realm.empty();
+		default: return true;
+		}
+	}
+
+	//usage + scope attributes; reuses the buffer to avoid allocation on lookup
+	std::string const& make_key(REDIRECT_HOST_USAGE usage, request_key const& req)
+	{
+		m_key.assign(1, char(usage));
+		switch (usage)
+		{
+		case REDIRECT_HOST_USAGE::ALL_SESSION:     m_key += req.session; break;
+		case REDIRECT_HOST_USAGE::ALL_REALM:       m_key += req.realm; break;
+		case REDIRECT_HOST_USAGE::ALL_HOST:        m_key += req.host; break;
+		case REDIRECT_HOST_USAGE::ALL_USER:        m_key += req.user; break;
+		case REDIRECT_HOST_USAGE::REALM_AND_APPLICATION:
+			m_key += req.realm;
+			m_key.push_back('\0');
+			[[fallthrough]];
+		case REDIRECT_HOST_USAGE::ALL_APPLICATION:
+		{
+			char app[sizeof(req.app)];
+			std::memcpy(app, &req.app, sizeof(app));
+			m_key.append(app, sizeof(app));
+		}
+		break;
+		default: break;
+		}
+		return m_key;
+	}
+
+	map_t       m_cache;
+	std::size_t m_count[NUM_USAGES] = {}; //number of entries per usage
+	std::string m_key;
+};
+
+}	//end: namespace diameter
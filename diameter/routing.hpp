@@ -0,0 +1,259 @@
+#pragma once
+/**
+@file
+RFC6733 2.7 Realm-Based Routing Table
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace diameter {
+
+enum class LOCAL_ACTION : uint8_t
+{
+	LOCAL,
+	RELAY,
+	PROXY,
+	REDIRECT,
+};
+
+//route for any application of the realm (Relay Application Id)
+constexpr uint32_t ANY_APPLICATION = 0xFFFFFFFF;
+
+struct route
+{
+	LOCAL_ACTION             action;
+	std::vector<std::string> peers; //Server-Identifiers
+};
+
+/*
+Routing table keyed by (realm, application) with longest suffix match on realm labels:
+"a.example.net" matches "a.example.net" then "example.net" then "net" then default route "".
+Realm comparison is case-insensitive. Built once and then used read-only (see router).
+*/
+class route_table
+{
+public:
+	//realm "" is the default route, app may be ANY_APPLICATION
+	void add(std::string_view realm, uint32_t app, route value)
+	{
+		uint64_t const h = hash(realm_hash(realm), app);
+		if (auto* e = lookup(h, realm, app))
+		{
+			m_entries[e - m_entries.data()].value = std::move(value);
+			return;
+		}
+		m_entries.push_back(entry{std::string{realm}, app, h, std::move(value)});
+		if (m_entries.size() * 2 > m_slots.size()) { rehash(); }
+		else { insert(m_entries.size() - 1); }
+	}
+
+	route const* find(std::string_view realm, uint32_t app) const
+	{
+		if (m_entries.empty()) { return nullptr; }
+
+		//hash each suffix at label boundary from right to left
+		constexpr std::size_t MAX_LABELS = 32;
+		std::size_t pos[MAX_LABELS];
+		uint64_t    hashes[MAX_LABELS];
+		std::size_t labels = 0;
+
+		uint64_t h = FNV_OFFSET;
+		for (std::size_t i = realm.size(); i-- > 0; )
+		{
+			h = (h ^ lower(realm[i])) * FNV_PRIME;
+			if (i == 0 || realm[i - 1] == '.')
+			{
+				//too many labels: hash each suffix separately
+				if (labels == MAX_LABELS) { return find_long(realm, app); }
+				pos[labels] = i;
+				hashes[labels] = h;
+				++labels;
+			}
+		}
+
+		//longest suffix first
+		while (labels-- > 0)
+		{
+			if (auto* e = match(hashes[labels], realm.substr(pos[labels]), app)) { return e; }
+		}
+		return match(FNV_OFFSET, {}, app);
+	}
+
+	std::size_t size() const                { return m_entries.size(); }
+
+private:
+	static constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+	static constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+	struct entry
+	{
+		std::string realm;
+		uint32_t    app;
+		uint64_t    hash;
+		route       value;
+	};
+
+	static char lower(char c)               { return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c; }
+
+	static bool equal(std::string_view a, std::string_view b)
+	{
+		if (a.size() != b.size()) { return false; }
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			if (lower(a[i]) != lower(b[i])) { return false; }
+		}
+		return true;
+	}
+
+	static uint64_t realm_hash(std::string_view realm)
+	{
+		uint64_t h = FNV_OFFSET;
+		for (std::size_t i = realm.size(); i-- > 0; ) { h = (h ^ lower(realm[i])) * FNV_PRIME; }
+		return h;
+	}
+
+	static uint64_t hash(uint64_t realm_hash, uint32_t app)
+	{
+		uint64_t h = (realm_hash ^ app) * 0x9E3779B97F4A7C15ULL;
+		return h ^ (h >> 32);
+	}
+
+	//entry of realm suffix for application or any application
+	route const* match(uint64_t suffix_hash, std::string_view suffix, uint32_t app) const
+	{
+		if (auto* e = lookup(hash(suffix_hash, app), suffix, app)) { return &e->value; }
+		auto* e = lookup(hash(suffix_hash, ANY_APPLICATION), suffix, ANY_APPLICATION);
+		return e ? &e->value : nullptr;
+	}
+
+	//same as find for realm of more than MAX_LABELS labels
+	route const* find_long(std::string_view realm, uint32_t app) const
+	{
+		for (std::size_t i = 0; i < realm.size(); )
+		{
+			std::string_view const suffix = realm.substr(i);
+			if (auto* e = match(realm_hash(suffix), suffix, app)) { return e; }
+			i = realm.find('.', i);
+			if (i == std::string_view::npos) { break; }
+			++i;
+		}
+		return match(FNV_OFFSET, {}, app);
+	}
+
+	entry const* lookup(uint64_t h, std::string_view realm, uint32_t app) const
+	{
+		if (m_slots.empty()) { return nullptr; }
+		std::size_t const mask = m_slots.size() - 1;
+		for (std::size_t i = h & mask; m_slots[i]; i = (i + 1) & mask)
+		{
+			entry const& e = m_entries[m_slots[i] - 1];
+			if (e.hash == h && e.app == app && equal(e.realm, realm)) { return &e; }
+		}
+		return nullptr;
+	}
+
+	void insert(std::size_t index)
+	{
+		std::size_t const mask = m_slots.size() - 1;
+		std::size_t i = m_entries[index].hash & mask;
+		while (m_slots[i]) { i = (i + 1) & mask; }
+		m_slots[i] = uint32_t(index + 1);
+	}
+
+	void rehash()
+	{
+		m_slots.assign(m_slots.empty() ? 16 : m_slots.size() * 2, 0);
+		for (std::size_t i = 0; i < m_entries.size(); ++i) { insert(i); }
+	}
+
+	std::vector<entry>    m_entries;
+	std::vector<uint32_t> m_slots; //index in m_entries + 1, 0 if empty
+};
+
+/*
+Current routing table which can be replaced at runtime as a whole.
+Lookups are done via per-thread route_cache.
+*/
+class router
+{
+public:
+	void update(std::shared_ptr<route_table const> table)
+	{
+		std::atomic_store(&m_table, std::move(table));
+		m_generation.fetch_add(1, std::memory_order_release);
+	}
+
+	std::shared_ptr<route_table const> table() const    { return std::atomic_load(&m_table); }
+	uint64_t generation() const                         { return m_generation.load(std::memory_order_acquire); }
+
+private:
+	std::shared_ptr<route_table const> m_table;
+	std::atomic<uint64_t>              m_generation{0};
+};
+
+/*
+Per-thread cache of route lookups (not thread-safe, one per worker thread).
+Holds the table it was populated from until the router is updated,
+so the returned route stays valid until the next find.
+*/
+class route_cache
+{
+public:
+	explicit route_cache(router const& r) : m_router{r} {}
+
+	route const* find(std::string_view realm, uint32_t app)
+	{
+		if (uint64_t const gen = m_router.generation(); gen != m_generation)
+		{
+			m_table = m_router.table();
+			m_generation = gen;
+			for (auto& s : m_slots) { s.used = false; }
+		}
+		if (!m_table) { return nullptr; }
+		if (realm.size() > MAX_REALM) { return m_table->find(realm, app); }
+
+		uint64_t h = app;
+		for (char c : realm) { h = (h ^ uint8_t(c)) * 0x100000001b3ULL; }
+		slot& s = m_slots[(h ^ (h >> 32)) % SLOTS];
+		if (!(s.used && s.hash == h && s.app == app && realm == std::string_view{s.realm, s.len}))
+		{
+			s.used = true;
+			s.hash = h;
+			s.app = app;
+			s.len = uint8_t(realm.size());
+			realm.copy(s.realm, realm.size());
+			s.value = m_table->find(realm, app);
+		}
+		return s.value;
+	}
+
+private:
+	static constexpr std::size_t SLOTS = 256;
+	static constexpr std::size_t MAX_REALM = 64;
+
+	struct slot
+	{
+		uint64_t     hash;
+		route const* value;
+		uint32_t     app;
+		uint8_t      len;
+		bool         used{false};
+		char         realm[MAX_REALM];
+	};
+
+	router const&                      m_router;
+	std::shared_ptr<route_table const> m_table;
+	uint64_t                           m_generation{~uint64_t(0)};
+	slot                               m_slots[SLOTS];
+};
+
+}	//end: namespace diameter
@@ -0,0 +1,261 @@
+#pragma once
+/**
+@file
+Raw scanning of encoded DIAMETER message: header and AVPs as views into the buffer,
+partial decode of selected AVPs only.
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace diameter {
+
+namespace detail {
+
+//single load of unaligned value and byte-swap
+inline uint32_t get_be32(uint8_t const* p)
+{
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+inline uint64_t get_be64(uint8_t const* p)
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+//single store of byte-swapped value
+inline void put_be32(uint8_t* p, uint32_t v)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	std::memcpy(p, &v, sizeof(v));
+}
+inline void put_be64(uint8_t* p, uint64_t v)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	std::memcpy(p, &v, sizeof(v));
+}
+
+//AVP length padded to 4 bytes
+constexpr std::size_t padded(std::size_t len) { return (len + 3) & ~std::size_t(3); }
+
+} //end: namespace detail
+
+/*
+Encoded message header (see header)
+*/
+struct header_view
+{
+	static constexpr std::size_t SIZE = 20;
+
+	uint8_t  version;
+	uint8_t  flags;
+	uint32_t length; //of whole message
+	uint32_t code;
+	uint32_t app_id;
+	uint32_t hop_id;
+	uint32_t end_id;
+
+	bool request() const                    { return flags & 0x80; }
+	//same as header::get_tag
+	uint32_t tag() const                    { return code | (request() ? 0x80000000 : 0); }
+
+	//false if too short or not a valid header
+	bool parse(void const* data, std::size_t size)
+	{
+		if (size < SIZE) { return false; }
+		auto const* p = static_cast<uint8_t const*>(data);
+		//version, length, flags, code | app_id, hop_id | end_id
+		uint64_t const w0 = detail::get_be64(p);
+		uint64_t const w1 = detail::get_be64(p + 8);
+		version = uint8_t(w0 >> 56);
+		length  = uint32_t(w0 >> 32) & 0xFFFFFF;
+		flags   = uint8_t(w0 >> 24);
+		code    = uint32_t(w0) & 0xFFFFFF;
+		app_id  = uint32_t(w1 >> 32);
+		hop_id  = uint32_t(w1);
+		end_id  = detail::get_be32(p + 16);
+		return version == 1 && length >= SIZE && (length % 4) == 0;
+	}
+
+	//into SIZE bytes
+	void encode(void* out) const
+	{
+		auto* p = static_cast<uint8_t*>(out);
+		detail::put_be64(p, (uint64_t(version) << 56) | (uint64_t(length & 0xFFFFFF) << 32)
+			| (uint64_t(flags) << 24) | (code & 0xFFFFFF));
+		detail::put_be64(p + 8, (uint64_t(app_id) << 32) | hop_id);
+		detail::put_be32(p + 16, end_id);
+	}
+};
+
+/*
+Encoded AVP (see detail::avp_header)
+*/
+struct avp_view
+{
+	uint8_t const* begin;   //of AVP
+	uint32_t       code;
+	uint32_t       length;  //of AVP w/o padding
+	uint32_t       vendor;  //0 if none
+	uint8_t        flags;
+
+	std::size_t header_size() const         { return (flags & 0x80) ? 12 : 8; }
+	uint8_t const* data() const             { return begin + header_size(); }
+	std::size_t size() const                { return length - header_size(); }
+	uint8_t const* end() const              { return begin + detail::padded(length); }
+
+	std::string_view str() const            { return {reinterpret_cast<char const*>(data()), size()}; }
+	//false if size of AVP data doesn't match the value
+	bool get(uint32_t& v) const
+	{
+		if (size() != sizeof(v)) { return false; }
+		v = detail::get_be32(data());
+		return true;
+	}
+	bool get(uint64_t& v) const
+	{
+		if (size() != sizeof(v)) { return false; }
+		v = detail::get_be64(data());
+		return true;
+	}
+};
+
+/*
+Sequential reader of encoded AVPs with validation of their lengths
+*/
+class avp_reader
+{
+public:
+	avp_reader(void const* data, std::size_t size)
+		: m_pos{static_cast<uint8_t const*>(data)}
+		, m_end{m_pos + size}
+	{}
+
+	//false at the end or on malformed AVP
+	bool next(avp_view& avp)
+	{
+		std::size_t const left = m_end - m_pos;
+		if (left < 8) { m_error = (left != 0); return false; }
+
+		//code | flags, length
+		uint64_t const w = detail::get_be64(m_pos);
+		avp.begin  = m_pos;
+		avp.code   = uint32_t(w >> 32);
+		avp.flags  = uint8_t(w >> 24);
+		avp.length = uint32_t(w) & 0xFFFFFF;
+		if (avp.length < avp.header_size() || avp.length > left)
+		{
+			m_error = true;
+			return false;
+		}
+		avp.vendor = (avp.flags & 0x80) ? detail::get_be32(m_pos + 8) : 0;
+
+		std::size_t const len = detail::padded(avp.length);
+		m_pos += (len <= left) ? len : left;
+		return true;
+	}
+
+	//true if stopped at malformed AVP
+	bool error() const                      { return m_error; }
+	//start of the next or malformed AVP
+	uint8_t const* position() const         { return m_pos; }
+
+private:
+	uint8_t const* m_pos;
+	uint8_t const* m_end;
+	bool           m_error{false};
+};
+
+/*
+Decodes only listed AVPs (first instance of each) skipping others by length
+and stops as soon as all of them are found, e.g.
+	partial<session_id, destination_realm, destination_host> routing;
+	if (routing.decode(data, size) && routing.get<destination_realm>()) ...
+*/
+template <class... FIELDS>
+class partial
+{
+public:
+	static constexpr std::size_t count = sizeof...(FIELDS);
+	static_assert(count > 0 && count <= 32, "UP TO 32 FIELDS");
+
+	header_view const& header() const       { return m_header; }
+
+	//false if header or AVPs up to the last found one are malformed
+	bool decode(void const* data, std::size_t size)
+	{
+		m_found = 0;
+		if (!m_header.parse(data, size) || m_header.length > size) { return false; }
+
+		avp_reader reader{static_cast<uint8_t const*>(data) + header_view::SIZE, m_header.length - header_view::SIZE};
+		avp_view avp;
+		while (reader.next(avp))
+		{
+			std::size_t const i = index(avp.code, avp.vendor, std::index_sequence_for<FIELDS...>{});
+			if (i < count && !(m_found & (1u << i)))
+			{
+				m_avps[i] = avp;
+				m_found |= (1u << i);
+				if (m_found == ALL) { return true; }
+			}
+		}
+		return !reader.error();
+	}
+
+	//encoded AVP or nullptr if not present
+	template <class FIELD>
+	avp_view const* get() const
+	{
+		constexpr std::size_t i = index_of<FIELD>(std::index_sequence_for<FIELDS...>{});
+		static_assert(i < count, "FIELD IS NOT IN THE LIST");
+		return (m_found & (1u << i)) ? &m_avps[i] : nullptr;
+	}
+
+	//true if all fields were found
+	bool complete() const                   { return m_found == ALL; }
+
+private:
+	static constexpr uint32_t ALL = (count == 32) ? ~0u : ((1u << count) - 1);
+
+	template <std::size_t... I>
+	static constexpr std::size_t index(uint32_t code, uint32_t vendor, std::index_sequence<I...>)
+	{
+		std::size_t i = count;
+		((code == FIELDS::id && vendor == static_cast<uint32_t>(FIELDS::vendor_value) ? (i = I, true) : false) || ...);
+		return i;
+	}
+
+	template <class FIELD, std::size_t... I>
+	static constexpr std::size_t index_of(std::index_sequence<I...>)
+	{
+		std::size_t i = count;
+		((std::is_same_v<FIELD, FIELDS> ? (i = I, true) : false) || ...);
+		return i;
+	}
+
+	header_view m_header;
+	avp_view    m_avps[count];
+	uint32_t    m_found{0};
+};
+
+}	//end: namespace diameter
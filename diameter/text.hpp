@@ -0,0 +1,243 @@
+#pragma once
+/**
+@file
+bounded text output into caller buffer w/o snprintf
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace diameter::text {
+
+/*
+Appends text into fixed buffer, silently truncates when it's full
+*/
+class sink
+{
+public:
+	sink(char* buf, std::size_t size)
+		: m_begin{buf}, m_pos{buf}, m_end{buf + size}
+	{}
+
+	void put(char c)
+	{
+		if (m_pos < m_end) { *m_pos++ = c; }
+		else { m_truncated = true; }
+	}
+
+	void put(std::string_view s)
+	{
+		std::size_t const n = (s.size() <= std::size_t(m_end - m_pos)) ? s.size() : std::size_t(m_end - m_pos);
+		std::memcpy(m_pos, s.data(), n);
+		m_pos += n;
+		m_truncated |= (n != s.size());
+	}
+
+	template <typename T>
+	void number(T v)
+	{
+		auto const res = std::to_chars(m_pos, m_end, v);
+		if (res.ec == std::errc{}) { m_pos = res.ptr; }
+		else { m_truncated = true; }
+	}
+
+	//lower-case hex w/o leading zeros
+	void hex(uint32_t v)
+	{
+		auto const res = std::to_chars(m_pos, m_end, v, 16);
+		if (res.ec == std::errc{}) { m_pos = res.ptr; }
+		else { m_truncated = true; }
+	}
+
+	//0x followed by 2 hex digits per byte
+	void hex(void const* data, std::size_t size)
+	{
+		static constexpr char digits[] = "0123456789ABCDEF";
+		auto const* p = static_cast<uint8_t const*>(data);
+		put("0x");
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			put(digits[p[i] >> 4]);
+			put(digits[p[i] & 0xF]);
+		}
+	}
+
+	//0x followed by 8 hex digits
+	void hex32(uint32_t v)
+	{
+		uint8_t const be[4] = {uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v)};
+		hex(be, sizeof(be));
+	}
+
+	//IPv4 dotted decimal or IPv6 as per RFC5952 from address in network order
+	void ip(void const* data, std::size_t size)
+	{
+		auto const* p = static_cast<uint8_t const*>(data);
+		if (size == 4)
+		{
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				if (i) { put('.'); }
+				number(unsigned(p[i]));
+			}
+		}
+		else if (size == 16 && p[10] == 0xFF && p[11] == 0xFF && !std::memcmp(p, ZERO, 10))
+		{
+			//IPv4-mapped as per RFC5952 5
+			put("::ffff:");
+			ip(p + 12, 4);
+		}
+		else if (size == 16)
+		{
+			uint16_t words[8];
+			for (std::size_t i = 0; i < 8; ++i) { words[i] = uint16_t((p[2*i] << 8) | p[2*i + 1]); }
+
+			//longest run of 2+ zero words is replaced by ::
+			std::size_t zbeg = 8, zlen = 0;
+			for (std::size_t i = 0; i < 8; )
+			{
+				std::size_t j = i;
+				while (j < 8 && words[j] == 0) { ++j; }
+				if (j - i > zlen && j - i > 1) { zbeg = i; zlen = j - i; }
+				i = (j == i) ? i + 1 : j;
+			}
+			for (std::size_t i = 0; i < 8; ++i)
+			{
+				if (i == zbeg)
+				{
+					put("::");
+					i += zlen - 1;
+					continue;
+				}
+				if (i && i != zbeg + zlen) { put(':'); }
+				hex(words[i]);
+			}
+		}
+		else
+		{
+			hex(p, size);
+		}
+	}
+
+	std::string_view str() const            { return {m_begin, std::size_t(m_pos - m_begin)}; }
+	std::size_t size() const                { return std::size_t(m_pos - m_begin); }
+	bool truncated() const                  { return m_truncated; }
+
+private:
+	static constexpr uint8_t ZERO[10] = {};
+
+	char*       m_begin;
+	char*       m_pos;
+	char*       m_end;
+	bool        m_truncated{false};
+};
+
+//IPv4 dotted decimal into 4 bytes
+inline bool parse_ipv4(std::string_view s, uint8_t* out)
+{
+	std::size_t i = 0;
+	for (std::size_t n = 0; n < 4; ++n)
+	{
+		if (n)
+		{
+			if (i >= s.size() || s[i] != '.') { return false; }
+			++i;
+		}
+		unsigned v = 0;
+		std::size_t const start = i;
+		while (i < s.size() && i - start < 3 && s[i] >= '0' && s[i] <= '9') { v = v * 10 + unsigned(s[i++] - '0'); }
+		//leading zero could be taken as octal
+		if (i == start || v > 255 || (s[start] == '0' && i - start > 1)) { return false; }
+		out[n] = uint8_t(v);
+	}
+	return i == s.size();
+}
+
+//IPv6 as per RFC4291 2.2 (incl. :: and trailing IPv4) into 16 bytes
+inline bool parse_ipv6(std::string_view s, uint8_t* out)
+{
+	auto const hex_digit = [](char c) -> int
+	{
+		if (c >= '0' && c <= '9') { return c - '0'; }
+		if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+		if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+		return -1;
+	};
+
+	uint16_t words[8];
+	std::size_t count = 0;
+	std::size_t gap = 8; //position of ::
+	std::size_t i = 0;
+	if (s.size() >= 2 && s[0] == ':' && s[1] == ':')
+	{
+		gap = 0;
+		i = 2;
+	}
+	while (i < s.size())
+	{
+		std::string_view const rest = s.substr(i);
+		if (rest.find(':') == std::string_view::npos && rest.find('.') != std::string_view::npos)
+		{
+			uint8_t v4[4];
+			if (count > 6 || !parse_ipv4(rest, v4)) { return false; }
+			words[count++] = uint16_t((v4[0] << 8) | v4[1]);
+			words[count++] = uint16_t((v4[2] << 8) | v4[3]);
+			break;
+		}
+
+		unsigned v = 0;
+		std::size_t const start = i;
+		for (int d; i < s.size() && i - start < 4 && (d = hex_digit(s[i])) >= 0; ++i) { v = (v << 4) | unsigned(d); }
+		if (i == start || count == 8) { return false; }
+		words[count++] = uint16_t(v);
+		if (i == s.size()) { break; }
+		if (s[i++] != ':') { return false; }
+		if (i < s.size() && s[i] == ':')
+		{
+			if (gap != 8) { return false; }
+			gap = count;
+			++i;
+		}
+		else if (i == s.size())
+		{
+			return false;
+		}
+	}
+	if ((gap == 8) ? (count != 8) : (count > 7)) { return false; }
+
+	std::memset(out, 0, 16);
+	std::size_t const tail = count - ((gap == 8) ? count : gap);
+	for (std::size_t w = 0; w < count; ++w)
+	{
+		std::size_t const pos = (w < count - tail) ? w : 8 - (count - w);
+		out[2*pos] = uint8_t(words[w] >> 8);
+		out[2*pos + 1] = uint8_t(words[w]);
+	}
+	return true;
+}
+
+//IPv4 or IPv6 text into out[16], returns size of address (4 or 16) or 0 if invalid
+inline std::size_t parse_ip(std::string_view s, uint8_t* out)
+{
+	if (s.find(':') == std::string_view::npos) { return parse_ipv4(s, out) ? 4 : 0; }
+	return parse_ipv6(s, out) ? 16 : 0;
+}
+
+//true if all bytes are printable ASCII
+inline bool printable(void const* data, std::size_t size)
+{
+	auto const* p = static_cast<uint8_t const*>(data);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		if (p[i] < 0x20 || p[i] > 0x7E) { return false; }
+	}
+	return true;
+}
+
+}	//end: namespace diameter::text
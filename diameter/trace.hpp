@@ -0,0 +1,130 @@
+#pragma once
+/**
+@file
+per-thread capture of raw frames into lock-free ring, formatted later by the reader
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "clock.hpp"
+
+namespace diameter {
+
+enum class TRACE : uint8_t
+{
+	RX,
+	TX,
+	PAD, //internal: skip to the start of ring
+};
+
+//captured frame as seen by the reader
+struct trace_entry
+{
+	uint64_t       timestamp; //ns since epoch
+	TRACE          direction;
+	uint8_t const* data;
+	std::size_t    size;
+};
+
+/*
+Single-producer (worker thread) single-consumer (background thread) ring of
+encoded frames with timestamp and direction. Fixed CAPACITY caps the memory:
+frames which don't fit are dropped and counted. Worker only copies the bytes,
+decoding and formatting (see format_frame) is done by the consumer.
+*/
+template <std::size_t CAPACITY>
+class trace_ring
+{
+public:
+	static_assert(CAPACITY >= 1024 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY MUST BE POWER OF 2");
+
+	//false if the frame was dropped (timestamp of coarse_clock unless given by caller)
+	bool push(TRACE dir, void const* data, std::size_t size, uint64_t timestamp = coarse_clock::now())
+	{
+		std::size_t const need = HDR_SIZE + aligned(size);
+		if (need > CAPACITY / 2) { return drop(); }
+
+		uint64_t head = m_head.load(std::memory_order_relaxed);
+		uint64_t const tail = m_tail.load(std::memory_order_acquire);
+		std::size_t pos = std::size_t(head & MASK);
+		std::size_t const to_end = CAPACITY - pos;
+		std::size_t const pad = (to_end < need) ? to_end : 0;
+		if (CAPACITY - std::size_t(head - tail) < need + pad) { return drop(); }
+
+		if (pad)
+		{
+			put_header(pos, 0, TRACE::PAD, pad - HDR_SIZE);
+			head += pad;
+			pos = 0;
+		}
+		put_header(pos, timestamp, dir, size);
+		std::memcpy(m_buf + pos + HDR_SIZE, data, size);
+		m_head.store(head + need, std::memory_order_release);
+		return true;
+	}
+
+	//calls func(trace_entry const&) for each captured frame, returns number of them
+	template <class FUNC>
+	std::size_t consume(FUNC&& func)
+	{
+		uint64_t tail = m_tail.load(std::memory_order_relaxed);
+		uint64_t const head = m_head.load(std::memory_order_acquire);
+		std::size_t count = 0;
+		while (tail != head)
+		{
+			std::size_t const pos = std::size_t(tail & MASK);
+			header hdr;
+			std::memcpy(&hdr, m_buf + pos, sizeof(hdr));
+			if (hdr.direction != TRACE::PAD)
+			{
+				func(trace_entry{hdr.timestamp, hdr.direction, m_buf + pos + HDR_SIZE, hdr.size});
+				++count;
+			}
+			tail += HDR_SIZE + aligned(hdr.size);
+		}
+		m_tail.store(tail, std::memory_order_release);
+		return count;
+	}
+
+	uint64_t dropped() const                { return m_dropped.load(std::memory_order_relaxed); }
+	static constexpr std::size_t capacity() { return CAPACITY; }
+
+private:
+	struct header
+	{
+		uint64_t timestamp;
+		uint32_t size;
+		TRACE    direction;
+	};
+	static constexpr std::size_t HDR_SIZE = 16;
+	static_assert(sizeof(header) <= HDR_SIZE);
+	static constexpr uint64_t MASK = CAPACITY - 1;
+
+	static constexpr std::size_t aligned(std::size_t size) { return (size + HDR_SIZE - 1) & ~(HDR_SIZE - 1); }
+
+	bool drop()
+	{
+		//only producer writes
+		m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void put_header(std::size_t pos, uint64_t timestamp, TRACE dir, std::size_t size)
+	{
+		header const hdr{timestamp, uint32_t(size), dir};
+		std::memcpy(m_buf + pos, &hdr, sizeof(hdr));
+	}
+
+	alignas(64) std::atomic<uint64_t> m_head{0};    //written by producer
+	std::atomic<uint64_t>             m_dropped{0};
+	alignas(64) std::atomic<uint64_t> m_tail{0};    //written by consumer
+	alignas(64) uint8_t               m_buf[CAPACITY];
+};
+
+}	//end: namespace diameter
@@ -0,0 +1,106 @@
+#pragma once
+/**
+@file
+compile-time traits of messages and grouped AVPs defined as med::set
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "avp.hpp"
+
+namespace diameter {
+
+namespace detail {
+
+constexpr std::size_t UNBOUNDED = std::numeric_limits<std::size_t>::max();
+
+//maximum instances by med::max<N> (med::inf is unbounded)
+template <class T> struct max_of { static constexpr std::size_t value = UNBOUNDED; };
+template <std::size_t N> struct max_of<med::max<N>> { static constexpr std::size_t value = N; };
+
+template <class... R>
+constexpr std::size_t max_count()
+{
+	if constexpr (sizeof...(R) == 0) { return 1; }
+	else { return std::min({max_of<R>::value...}); }
+}
+
+//AVP of M<AVP, ...> or O<AVP, ...> and its multiplicity
+template <class T> struct field_of;
+template <class T, class... R> struct field_of<med::mandatory<T, R...>>
+{
+	using type = T;
+	static constexpr bool mandatory = true;
+	static constexpr std::size_t max = max_count<R...>();
+	static constexpr bool single = (max == 1);
+};
+template <class T, class... R> struct field_of<med::optional<T, R...>>
+{
+	using type = T;
+	static constexpr bool mandatory = false;
+	static constexpr std::size_t max = max_count<R...>();
+	static constexpr bool single = (max == 1);
+};
+
+//fields of the message derived from med::set
+template <class... FIELDS>
+std::tuple<field_of<FIELDS>...> set_traits(med::set<FIELDS...> const*);
+template <class... FIELDS>
+std::tuple<typename field_of<FIELDS>::type...> set_fields(med::set<FIELDS...> const*);
+
+template <class MSG>
+using traits_of = decltype(set_traits(static_cast<MSG const*>(nullptr)));
+template <class MSG>
+using fields_of = decltype(set_fields(static_cast<MSG const*>(nullptr)));
+
+//any_avp and alike w/o fixed code collect all unlisted AVPs
+template <class T, class = void>
+struct has_code : std::false_type {};
+template <class T>
+struct has_code<T, std::void_t<decltype(T::id)>> : std::true_type {};
+
+template <class T>
+constexpr uint32_t code_of()
+{
+	if constexpr (has_code<T>::value) { return T::id; }
+	else { return 0; }
+}
+
+template <class T>
+constexpr uint32_t vendor_of()
+{
+	if constexpr (has_code<T>::value) { return static_cast<uint32_t>(T::vendor_value); }
+	else { return 0; }
+}
+
+//grouped AVP (incl. lazy) with its AVPs in set_type
+template <class T, class = void>
+struct is_grouped : std::false_type {};
+template <class T>
+struct is_grouped<T, std::void_t<typename T::set_type>> : std::true_type {};
+
+//lazy grouped AVP with AVPs decoded on first access
+template <class T, class = void>
+struct is_lazy : std::false_type {};
+template <class T>
+struct is_lazy<T, std::void_t<decltype(std::declval<T const&>().expanded())>> : std::true_type {};
+
+//type of value of the AVP
+template <class T> struct type_is { using type = T; };
+template <class VALUE, uint32_t CODE, uint8_t FLAGS, VENDOR VND>
+type_is<VALUE> value_of(avp_header<VALUE, CODE, FLAGS, VND> const*);
+
+template <class AVP>
+using avp_value_t = typename decltype(value_of(static_cast<AVP const*>(nullptr)))::type;
+
+} //end: namespace detail
+
+}	//end: namespace diameter
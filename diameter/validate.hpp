@@ -0,0 +1,215 @@
+#pragma once
+/**
+@file
+exception-free decode: structural validation with RFC6733 7.1 result codes
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "med/decoder_context.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/decode.hpp"
+
+#include "base.hpp"
+#include "choice.hpp"
+#include "scan.hpp"
+#include "traits.hpp"
+
+namespace diameter {
+
+/*
+Outcome of decode: result code and the offending AVP.
+Offset and length locate the AVP in the input to be copied into Failed-AVP, e.g.
+	ans.ref<failed_avp>().set(status.length, data + status.offset);
+For a missing AVP only its code is known (length is 0).
+*/
+struct decode_status
+{
+	RESULT   result{RESULT::SUCCESS};
+	uint32_t avp_code{0};
+	uint32_t offset{0};  //of AVP from start of message
+	uint32_t length{0};  //of AVP incl. header
+
+	explicit operator bool() const          { return result == RESULT::SUCCESS; }
+};
+
+namespace detail {
+
+inline decode_status failed(RESULT res, uint32_t code = 0, std::size_t offset = 0, std::size_t length = 0)
+{
+	return decode_status{res, code, uint32_t(offset), uint32_t(length)};
+}
+
+//header and lengths of all AVPs
+inline decode_status validate_structure(header_view& hdr, uint8_t const* data, std::size_t size)
+{
+	if (!hdr.parse(data, size))
+	{
+		return failed((size >= header_view::SIZE && hdr.version != 1)
+			? RESULT::UNSUPPORTED_VERSION : RESULT::INVALID_MESSAGE_LENGTH);
+	}
+	if (hdr.length > size) { return failed(RESULT::INVALID_MESSAGE_LENGTH); }
+	//E-bit in request
+	if (hdr.request() && (hdr.flags & 0x20)) { return failed(RESULT::INVALID_HDR_BITS); }
+
+	avp_reader reader{data + header_view::SIZE, hdr.length - header_view::SIZE};
+	avp_view avp;
+	while (reader.next(avp)) {}
+	if (reader.error())
+	{
+		std::size_t const offset = reader.position() - data;
+		uint32_t const code = (hdr.length - offset >= 4) ? get_be32(reader.position()) : 0;
+		return failed(RESULT::INVALID_AVP_LENGTH, code, offset, hdr.length - offset);
+	}
+	return {};
+}
+
+//data size of AVP with fixed width value (e.g. Unsigned32 or Time) or 0 if variable
+template <class T>
+constexpr uint32_t fixed_size_of()
+{
+	if constexpr (!has_code<T>::value || is_grouped<T>::value) { return 0; }
+	else
+	{
+		using value_type = avp_value_t<T>;
+		if constexpr (std::is_same_v<time, value_type>) { return 4; }
+		else if constexpr (std::is_same_v<med::IE_VALUE, typename value_type::ie_type>) { return sizeof(typename value_type::value_type); }
+		else { return 0; }
+	}
+}
+
+//occurrences of the fields of MSG and data sizes of fixed width ones
+template <class MSG, std::size_t... I>
+decode_status validate_fields(uint8_t const* data, std::size_t length, std::index_sequence<I...>)
+{
+	using traits = traits_of<MSG>;
+	constexpr std::size_t count = sizeof...(I);
+	constexpr uint32_t codes[] = {code_of<typename std::tuple_element_t<I, traits>::type>()...};
+	constexpr uint32_t vendors[] = {vendor_of<typename std::tuple_element_t<I, traits>::type>()...};
+	constexpr bool known[] = {has_code<typename std::tuple_element_t<I, traits>::type>::value...};
+	constexpr std::size_t maxes[] = {std::tuple_element_t<I, traits>::max...};
+	constexpr bool mandatory[] = {std::tuple_element_t<I, traits>::mandatory...};
+	constexpr uint32_t sizes[] = {fixed_size_of<typename std::tuple_element_t<I, traits>::type>()...};
+	uint32_t seen[count] = {};
+
+	auto const field = [&](avp_view const& avp)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (known[i] && codes[i] == avp.code && vendors[i] == avp.vendor) { return i; }
+		}
+		return count;
+	};
+
+	avp_reader reader{data + header_view::SIZE, length - header_view::SIZE};
+	avp_view avp;
+	//instances of multi-instance AVP (e.g. Route-Record) usually follow each other
+	std::size_t last = count;
+	while (reader.next(avp))
+	{
+		std::size_t const i = (last < count && codes[last] == avp.code && vendors[last] == avp.vendor) ? last : field(avp);
+		if (i == count) { continue; }
+		if (sizes[i] && avp.size() != sizes[i])
+		{
+			return failed(RESULT::INVALID_AVP_LENGTH, avp.code, avp.begin - data, avp.length);
+		}
+		if (++seen[i] > maxes[i])
+		{
+			return failed(RESULT::AVP_OCCURS_TOO_MANY_TIMES, avp.code, avp.begin - data, avp.length);
+		}
+		last = i;
+	}
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (mandatory[i] && !seen[i]) { return failed(RESULT::MISSING_AVP, codes[i]); }
+	}
+	return {};
+}
+
+//validates message of alternative if it matches the tag
+template <class ALT> struct alternative
+{
+	static bool validate(uint32_t, uint8_t const*, std::size_t, decode_status&) { return false; }
+};
+template <class TAG, class MSG> struct alternative<med::mandatory<TAG, MSG>>
+{
+	static bool validate(uint32_t tag, uint8_t const* data, std::size_t length, decode_status& status)
+	{
+		if constexpr (has_msg_code<MSG>::value)
+		{
+			using alt = med::mandatory<TAG, MSG>;
+			if constexpr (std::is_same_v<alt, request<MSG>> || std::is_same_v<alt, answer<MSG>>)
+			{
+				constexpr uint32_t expected = std::is_same_v<alt, request<MSG>> ? (REQUEST | MSG::code) : MSG::code;
+				if (tag != expected) { return false; }
+				status = validate_fields<MSG>(data, length
+					, std::make_index_sequence<std::tuple_size_v<traits_of<MSG>>>{});
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+//message of choice selected by header (unknown ones are left to decoder)
+template <class HDR, class... ALTS>
+decode_status validate_choice(med::choice<HDR, ALTS...> const&, uint8_t const* data, header_view const& hdr)
+{
+	decode_status status;
+	(alternative<ALTS>::validate(hdr.tag(), data, hdr.length, status) || ...);
+	return status;
+}
+
+} //end: namespace detail
+
+/*
+Validates encoded MSG (e.g. STR) without decoding it: header, AVP lengths,
+presence of mandatory AVPs and number of instances up to the maximum of each field.
+*/
+template <class MSG>
+decode_status validate(void const* data, std::size_t size)
+{
+	auto const* p = static_cast<uint8_t const*>(data);
+	header_view hdr;
+	if (auto status = detail::validate_structure(hdr, p, size); !status) { return status; }
+	return detail::validate_fields<MSG>(p, hdr.length
+		, std::make_index_sequence<std::tuple_size_v<detail::traits_of<MSG>>>{});
+}
+
+/*
+Decodes message (e.g. diameter::base) without throwing:
+malformed input is rejected by validation of the selected message before med decode,
+so exceptions are left only for the cases validation doesn't cover.
+*/
+template <class DIA>
+decode_status try_decode(DIA& dia, void const* data, std::size_t size, med::allocator& alloc) noexcept
+{
+	auto const* p = static_cast<uint8_t const*>(data);
+	header_view hdr;
+	if (auto status = detail::validate_structure(hdr, p, size); !status) { return status; }
+	if (auto status = detail::validate_choice(dia, p, hdr); !status) { return status; }
+
+	try
+	{
+		//header is already parsed, med decodes only AVPs of the known message
+		if (!detail::decode_selected(dia, &dia, hdr, p, alloc))
+		{
+			med::decoder_context<med::allocator> ctx{p, hdr.length, &alloc};
+			decode(med::octet_decoder{ctx}, dia);
+		}
+	}
+	catch (...)
+	{
+		return detail::failed(RESULT::UNABLE_TO_COMPLY);
+	}
+	return {};
+}
+
+}	//end: namespace diameter
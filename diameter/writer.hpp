@@ -0,0 +1,174 @@
+#pragma once
+/**
+@file
+direct encoder of message header and AVPs into buffer by 32-bit word stores
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "ip.hpp"
+#include "scan.hpp"
+#include "traits.hpp"
+
+namespace diameter {
+
+/*
+Encodes AVPs of known types (e.g. result_code, origin_host) in the order they are added.
+Header words of an AVP are compile-time constants from its code, flags and vendor:
+fixed-size AVPs are written as a few big-endian stores, the padding of string ones
+as one zero word before the data is copied. Overflow of buffer is sticky (see ok), e.g.
+	avp_writer w{buf, sizeof(buf)};
+	w.header(diameter::CEA::code, 0, hop, end);
+	w.add<diameter::result_code>(diameter::RESULT::SUCCESS);
+	w.add<diameter::origin_host>("host.example.net"sv);
+	auto const size = w.finish();
+*/
+class avp_writer
+{
+public:
+	avp_writer(void* buf, std::size_t size)
+		: m_begin{static_cast<uint8_t*>(buf)}, m_pos{m_begin}, m_end{m_begin + size}
+	{}
+
+	//message header, length is set by finish()
+	void header(uint32_t tag, uint32_t app, uint32_t hop, uint32_t end, uint8_t flags = 0)
+	{
+		if (!room(header_view::SIZE)) { return; }
+		m_msg = m_pos;
+		header_view const hdr{1, uint8_t(flags | ((tag & REQUEST) ? 0x80 : 0)), 0, tag & 0xFFFFFF, app, hop, end};
+		hdr.encode(m_pos);
+		m_pos += header_view::SIZE;
+	}
+
+	//length of message (from header), 0 if it didn't fit
+	std::size_t finish()
+	{
+		if (!ok() || !m_msg) { return 0; }
+		std::size_t const len = std::size_t(m_pos - m_msg);
+		detail::put_be32(m_msg, 0x01000000 | uint32_t(len));
+		return len;
+	}
+
+	//AVP of Unsigned32/64, Integer32/64 or Enumerated
+	template <class AVP, typename T, class = std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+	void add(T v)
+	{
+		using value_type = typename detail::avp_value_t<AVP>::value_type;
+		static_assert(sizeof(value_type) == 4 || sizeof(value_type) == 8, "FIXED-SIZE AVP EXPECTED");
+		constexpr std::size_t len = hdr_size<AVP>() + sizeof(value_type);
+		if (!room(len)) { return; }
+		put_header<AVP>(len);
+		if constexpr (sizeof(value_type) == 4) { detail::put_be32(m_pos + hdr_size<AVP>(), uint32_t(v)); }
+		else { detail::put_be64(m_pos + hdr_size<AVP>(), uint64_t(v)); }
+		m_pos += len;
+	}
+
+	//AVP of OctetString and derived
+	template <class AVP>
+	void add(void const* data, std::size_t size)
+	{
+		std::size_t const len = hdr_size<AVP>() + size;
+		std::size_t const padded = detail::padded(len);
+		if (!room(padded)) { return; }
+		put_header<AVP>(len);
+		if (padded != len) { detail::put_be32(m_pos + padded - 4, 0); }
+		std::memcpy(m_pos + hdr_size<AVP>(), data, size);
+		m_pos += padded;
+	}
+
+	template <class AVP>
+	void add(std::string_view s)            { add<AVP>(s.data(), s.size()); }
+
+	//AVP of Address
+	template <class AVP>
+	void add(ip_address const& ip)
+	{
+		std::size_t const len = hdr_size<AVP>() + 2 + ip.size();
+		std::size_t const padded = detail::padded(len);
+		if (ip.empty() || !room(padded)) { return; }
+		put_header<AVP>(len);
+		detail::put_be32(m_pos + padded - 4, 0);
+		uint8_t* p = m_pos + hdr_size<AVP>();
+		p[0] = 0;
+		p[1] = ip.is_v4() ? 1 : 2; //IANA address family (see address)
+		std::memcpy(p + 2, ip.data(), ip.size());
+		m_pos += padded;
+	}
+
+	//encoded AVP as is (e.g. from avp_reader)
+	void copy(avp_view const& avp)
+	{
+		std::size_t const padded = detail::padded(avp.length);
+		if (!room(padded)) { return; }
+		if (padded != avp.length) { detail::put_be32(m_pos + padded - 4, 0); }
+		std::memcpy(m_pos, avp.begin, avp.length);
+		m_pos += padded;
+	}
+
+	//grouped AVP: all added until end_group are inside it
+	template <class AVP>
+	std::size_t begin_group()
+	{
+		std::size_t const pos = size();
+		if (room(hdr_size<AVP>()))
+		{
+			put_header<AVP>(0);
+			m_pos += hdr_size<AVP>();
+		}
+		return pos;
+	}
+
+	void end_group(std::size_t pos)
+	{
+		if (!ok()) { return; }
+		uint8_t* p = m_begin + pos + 4;
+		detail::put_be32(p, (uint32_t(p[0]) << 24) | uint32_t(m_pos - m_begin - pos));
+	}
+
+	bool ok() const                         { return !m_overflow; }
+	std::size_t size() const                { return std::size_t(m_pos - m_begin); }
+	uint8_t const* data() const             { return m_begin; }
+
+private:
+	template <class AVP>
+	static constexpr std::size_t hdr_size() { return (AVP::vendor_value == VENDOR::NONE) ? 8 : 12; }
+
+	//same as set by avp_header
+	template <class AVP>
+	static constexpr uint32_t flags_of()
+	{
+		return (AVP::vendor_value == VENDOR::NONE) ? (AVP::flags_value & ~avp_flags::V) : (AVP::flags_value | avp_flags::V);
+	}
+
+	template <class AVP>
+	void put_header(std::size_t len)
+	{
+		detail::put_be32(m_pos, AVP::id);
+		detail::put_be32(m_pos + 4, (flags_of<AVP>() << 24) | uint32_t(len));
+		if constexpr (AVP::vendor_value != VENDOR::NONE)
+		{
+			detail::put_be32(m_pos + 8, static_cast<uint32_t>(AVP::vendor_value));
+		}
+	}
+
+	bool room(std::size_t len)
+	{
+		if (!m_overflow && std::size_t(m_end - m_pos) < len) { m_overflow = true; }
+		return !m_overflow;
+	}
+
+	uint8_t*       m_begin;
+	uint8_t*       m_pos;
+	uint8_t*       m_end;
+	uint8_t*       m_msg{nullptr};
+	bool           m_overflow{false};
+};
+
+}	//end: namespace diameter
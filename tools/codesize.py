@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""
+Code size of a library or executable per DIAMETER message.
+
+Sums sizes of code symbols (nm) by the message type found in their
+demangled names, e.g. diameter::CER or diameter::cc::CCA. Symbols naming no
+message or more than one (header, AVPs shared by messages, choice dispatch
+over all of them) are "common".
+
+usage: codesize.py <binary> [--nm <nm>]
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+#message type is 3 capitals as in RFC abbreviations (CER, CCA, ...)
+MESSAGE = re.compile(r'\bdiameter::(?:\w+::)?([A-Z]{3})\b')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('binary')
+    ap.add_argument('--nm', default='nm')
+    args = ap.parse_args()
+
+    out = subprocess.run([args.nm, '-C', '-S', '--size-sort', args.binary],
+        check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+
+    sizes = {}
+    counts = {}
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        #address size type name
+        if len(parts) != 4 or parts[2] not in 'tTwW':
+            continue
+        messages = set(MESSAGE.findall(parts[3]))
+        key = messages.pop() if len(messages) == 1 else 'common'
+        sizes[key] = sizes.get(key, 0) + int(parts[1], 16)
+        counts[key] = counts.get(key, 0) + 1
+
+    total = sum(sizes.values())
+    print('{:<8} {:>10} {:>8}'.format('message', 'bytes', 'symbols'))
+    for key in sorted(sizes, key=lambda k: -sizes[k]):
+        print('{:<8} {:>10} {:>8}'.format(key, sizes[key], counts[key]))
+    print('{:<8} {:>10} {:>8}'.format('total', total, sum(counts.values())))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
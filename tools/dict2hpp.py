@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+"""
+DIAMETER dictionary to med-based header generator.
+
+Turns a dictionary file (see README.md, "Dictionaries") into a header with
+AVP, enumeration (with its enum_names table) and message definitions in the same style as base_avps.hpp
+and base.hpp.
+
+usage: dict2hpp.py <input.dict> [-o <output.hpp>] [--check]
+
+  -o       write the result to the file instead of stdout
+  --check  compare the result with the existing output file, fail if it differs
+"""
+
+import argparse
+import re
+import sys
+
+TYPES = {
+    'OctetString': 'med::octet_string<>',
+    'UTF8String':  'med::ascii_string<>',
+    'DiamIdent':   'med::ascii_string<>',
+    'DiamURI':     'med::ascii_string<>',
+    'Address':     'address',
+    'Time':        'time',
+    'Integer32':   'integer32',
+    'Integer64':   'integer64',
+    'Unsigned32':  'unsigned32',
+    'Unsigned64':  'unsigned64',
+}
+
+FLAGS = {'M': 'avp_flags::M', 'P': 'avp_flags::P'}
+
+CXX_KEYWORDS = {
+    'class', 'default', 'delete', 'new', 'operator', 'private', 'protected',
+    'public', 'register', 'signed', 'template', 'this', 'union', 'unsigned',
+}
+
+#name of AVP/message as in RFC into C++ identifier
+def ident(name):
+    s = name.replace('-', '_')
+    if s.lower() in CXX_KEYWORDS:
+        return s[0].upper() + s[1:].lower()
+    return s.lower()
+
+
+class Error(Exception):
+    def __init__(self, line, msg):
+        super().__init__('line {}: {}'.format(line, msg))
+
+
+class Field:
+    #RFC6733 3.2 Command Code Format Specification: [qual] "<"/"{"/"[" name ">"/"}"/"]"
+    #max of qual may also be a named constant, e.g. *MAX_ROUTE_RECORD[ Route-Record ]
+    RE = re.compile(r'^(?:(\d*)\*(\d*|[A-Z][A-Z0-9_]*))?\s*([<{\[])\s*([\w-]+)\s*([>}\]])$')
+
+    def __init__(self, line, text):
+        m = Field.RE.match(text)
+        if not m:
+            raise Error(line, 'invalid field: ' + text)
+        lo, hi, open_, name = m.group(1), m.group(2), m.group(3), m.group(4)
+        if (open_, m.group(5)) not in (('<', '>'), ('{', '}'), ('[', ']')):
+            raise Error(line, 'unbalanced brackets: ' + text)
+        self.text = text
+        self.name = name
+        multi = '*' in text.split(open_)[0]
+        #default minimum with qualifier is 1 for required rule and 0 for fixed or optional one
+        lo = int(lo) if lo else ((1 if open_ == '{' else 0) if multi else 1)
+        hi = (int(hi) if hi.isdigit() else hi) if hi else (0 if multi else 1)
+        if open_ == '[' and multi and lo > 0:
+            raise Error(line, 'minimum of optional rule must be 0: ' + text)
+        #optional if not required or zero repetitions allowed
+        self.mandatory = open_ != '[' and lo > 0
+        #0 is unbounded, name of constant is bounded by its value
+        self.max = hi if hi else (0 if multi else 1)
+
+    def cxx(self, avps):
+        name = 'any_avp' if self.name == 'AVP' else avps.get(self.name, ident(self.name))
+        args = [name]
+        if isinstance(self.max, str):
+            args.append('med::max<{}>'.format(self.max))
+        elif self.max == 0:
+            args.append('med::inf')
+        elif self.max > 1:
+            args.append('med::max<{}>'.format(self.max))
+        return '{}< {} >'.format('M' if self.mandatory else 'O', ', '.join(args))
+
+
+class Dictionary:
+    def __init__(self):
+        self.title = None
+        self.namespace = 'diameter'
+        self.includes = []
+        self.enums = []         #(name, [(item, value)])
+        self.avps = []          #dict(name, code, type, flags, vendor, fields)
+        self.messages = []      #dict(name, code, flags, title, fields, ccf)
+        self.applications = []  #(name, [message])
+
+    def parse(self, text):
+        block = None
+        for num, raw in enumerate(text.splitlines(), 1):
+            line = raw.split('#', 1)[0].strip()
+            if not line:
+                continue
+            words = line.split()
+            key = words[0]
+
+            if block is not None:
+                if key == 'end':
+                    block = None
+                elif isinstance(block, list):
+                    m = re.match(r'^(\w+)\s*=\s*(\d+)$', line)
+                    if not m:
+                        raise Error(num, 'invalid enum item: ' + line)
+                    block.append((m.group(1), int(m.group(2))))
+                else:
+                    block['fields'].append(Field(num, line))
+                continue
+
+            if key == 'title':
+                self.title = line[len(key):].strip()
+            elif key == 'namespace' and len(words) == 2:
+                self.namespace = words[1]
+            elif key == 'include' and len(words) == 2:
+                self.includes.append(words[1])
+            elif key == 'enum' and len(words) == 2:
+                block = []
+                self.enums.append((words[1], block))
+            elif key == 'avp' and len(words) in (4, 5, 6):
+                #avp <Name> <Code> <Type> [<Flags>] [<Vendor>]
+                self.avps.append(self.avp(num, words[1:], None))
+            elif key == 'grouped' and len(words) in (3, 4, 5, 6):
+                #grouped <Name> <Code> [<Flags>] [<Vendor>] [lazy]
+                lazy = words[-1] == 'lazy'
+                if lazy:
+                    words = words[:-1]
+                block = self.avp(num, words[1:3] + ['Grouped'] + words[3:], [])
+                block['lazy'] = lazy
+                self.avps.append(block)
+            elif key == 'message' and len(words) >= 3:
+                #message <Abbr> <Code> [REQ] [PXY] <Full-Name>
+                flags = [w for w in words[3:] if w in ('REQ', 'PXY')]
+                rest = [w for w in words[3:] if w not in ('REQ', 'PXY')]
+                if len(rest) != 1 or not words[2].isdigit():
+                    raise Error(num, 'expected: message <Abbr> <Code> [REQ] [PXY] <Full-Name>')
+                block = dict(name=words[1], code=int(words[2]), flags=flags, title=rest[0], fields=[])
+                self.messages.append(block)
+            elif key == 'application' and len(words) >= 3:
+                self.applications.append((words[1], words[2:]))
+            else:
+                raise Error(num, 'unexpected: ' + line)
+
+        if block is not None:
+            raise Error(num, 'missing "end"')
+        return self
+
+    def avp(self, num, words, fields):
+        name, code, type_ = words[0], words[1], words[2]
+        if not code.isdigit():
+            raise Error(num, 'invalid AVP code: ' + code)
+        flags = words[3] if len(words) > 3 else '-'
+        vendor = words[4] if len(words) > 4 else None
+        flags = [] if flags in ('-', '0') else flags.split(',')
+        for f in flags:
+            if f not in FLAGS:
+                raise Error(num, 'invalid AVP flag: ' + f)
+        m = re.match(r'^Enumerated\((\w+)\)$', type_)
+        if m:
+            type_ = 'enumerated<{}>'.format(m.group(1))
+        elif type_ == 'Grouped':
+            if fields is None:
+                raise Error(num, 'use "grouped" for Grouped AVP')
+        elif type_ in TYPES:
+            type_ = TYPES[type_]
+        else:
+            raise Error(num, 'unsupported AVP type: ' + type_)
+        return dict(name=name, code=int(code), type=type_, flags=flags, vendor=vendor, fields=fields, lazy=False)
+
+    #grouped AVPs go after the AVPs they refer to
+    def ordered_avps(self):
+        by_name = {a['name']: a for a in self.avps}
+        done, out = set(), []
+
+        def visit(a, path):
+            if a['name'] in done:
+                return
+            if a['name'] in path:
+                raise Error(0, 'recursive grouped AVP: ' + a['name'])
+            for f in a['fields'] or []:
+                if f.name in by_name:
+                    visit(by_name[f.name], path + [a['name']])
+            done.add(a['name'])
+            out.append(a)
+
+        for a in self.avps:
+            visit(a, [])
+        return out
+
+
+def emit(d, source):
+    out = []
+    w = out.append
+    avps = {a['name']: ident(a['name']) for a in d.avps}
+    includes = d.includes or ['base.hpp']
+    if d.enums and 'enum_names.hpp' not in includes:
+        includes = includes + ['enum_names.hpp']
+
+    w('#pragma once')
+    w('/**')
+    w('@file')
+    w('{} definition in med (https://github.com/cppden/med)'.format(d.title or 'DIAMETER application'))
+    w('')
+    w('Generated by tools/dict2hpp.py from {} - DO NOT EDIT.'.format(source))
+    w('')
+    w('Distributed under the MIT License')
+    w('(See accompanying file LICENSE or visit https://github.com/cppden/med)')
+    w('*/')
+    w('')
+    for inc in includes:
+        w('#include "{}"'.format(inc))
+    w('')
+    w('namespace {} {{'.format(d.namespace))
+    w('')
+
+    for name, items in d.enums:
+        width = max(len(i) for i, _ in items)
+        w('enum class {} : uint32_t'.format(name))
+        w('{')
+        for item, value in items:
+            w('\t{} = {},'.format(item.ljust(width), value))
+        w('};')
+        w('')
+
+    for a in d.ordered_avps():
+        flags = ' | '.join(FLAGS[f] for f in a['flags'])
+        vendor = 'VENDOR::' + a['vendor'] if a['vendor'] else None
+        if a['fields'] is not None:
+            if len(a['fields']) < 2:
+                raise Error(0, 'grouped AVP with single field, use plain AVP: ' + a['name'])
+            #lazy grouped AVPs are decoded on demand (see lazy.hpp)
+            grouped = 'lazy_grouped' if a['lazy'] else 'avp_grouped'
+            w('struct {} : {}<{}, {}, {}'.format(ident(a['name']), grouped, a['code'], flags or '0', vendor or 'VENDOR::NONE'))
+            for f in a['fields']:
+                w('\t, {}'.format(f.cxx(avps)))
+            w('>')
+        else:
+            args = [a['type'], str(a['code'])]
+            if flags or vendor:
+                args.append(flags or '0')
+            if vendor:
+                args.append(vendor)
+            w('struct {} : avp<{}>'.format(ident(a['name']), ', '.join(args)))
+        w('{')
+        w('\tstatic constexpr char const* name() {{ return "{}"; }}'.format(a['name']))
+        w('};')
+        w('')
+
+    for m in d.messages:
+        w('/*')
+        hdr = ', '.join([str(m['code'])] + m['flags'])
+        w('<{}> ::= < Diameter Header: {} >'.format(m['name'], hdr))
+        for f in m['fields']:
+            w('\t' + f.text)
+        w('*/')
+        w('struct {} : med::set<'.format(m['name']))
+        w(',\n'.join('\t' + f.cxx(avps) for f in m['fields']))
+        w('>')
+        w('{')
+        w('\tstatic constexpr std::size_t code = {};'.format(m['code']))
+        w('\tstatic constexpr char const* name() {{ return "{}"; }}'.format(m['title']))
+        w('};')
+        w('')
+
+    by_name = {m['name']: m for m in d.messages}
+    for name, msgs in d.applications:
+        w('struct {} : med::choice< header'.format(name))
+        for msg in msgs:
+            if msg not in by_name:
+                raise Error(0, 'unknown message in application {}: {}'.format(name, msg))
+            w('\t, {}<{}>'.format('request' if 'REQ' in by_name[msg]['flags'] else 'answer', msg))
+        w('\t, med::mandatory<any_request, Request>')
+        w('\t, med::mandatory<any_answer, Answer>')
+        w('>')
+        w('{')
+        w('\tusing length_type = length;')
+        w('};')
+        w('')
+
+    #name tables of enumerations (see enum_names.hpp) are specialized in namespace diameter
+    if d.enums and d.namespace != 'diameter':
+        w('}}\t//end: namespace {}'.format(d.namespace))
+        w('')
+        w('namespace diameter {')
+        w('')
+    if d.namespace == 'diameter':
+        scope = ''
+    elif d.namespace.startswith('diameter::'):
+        scope = d.namespace[len('diameter::'):] + '::'
+    else:
+        scope = '::' + d.namespace + '::'
+    for name, items in d.enums:
+        w('template <> struct enum_names<{}{}>'.format(scope, name))
+        w('{')
+        w('\tusing type = {}{};'.format(scope, name))
+        w('\tstatic constexpr enum_entry<type> entries[] = {')
+        for item, _ in items:
+            w('\t\t{{type::{}, "{}"}},'.format(item, item))
+        w('\t};')
+        w('\tstatic constexpr enum_table table{entries};')
+        w('};')
+        w('')
+
+    w('}}\t//end: namespace {}'.format(d.namespace if not d.enums else 'diameter'))
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    ap = argparse.ArgumentParser(description='DIAMETER dictionary to med-based header generator')
+    ap.add_argument('input')
+    ap.add_argument('-o', '--output')
+    ap.add_argument('--check', action='store_true')
+    args = ap.parse_args()
+
+    try:
+        with open(args.input) as f:
+            src = args.input.replace('\\', '/')
+            if '/dict/' in src:
+                src = 'dict/' + src.rsplit('/dict/', 1)[1]
+            text = emit(Dictionary().parse(f.read()), src)
+    except Error as ex:
+        sys.exit('{}: {}'.format(args.input, ex))
+
+    if args.check:
+        if not args.output:
+            sys.exit('--check requires -o')
+        with open(args.output) as f:
+            if f.read() != text:
+                sys.exit('{} is out of date, regenerate from {}'.format(args.output, args.input))
+    elif args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Check of hand-written name tables in diameter/enum_names.hpp.
+
+Every enumeration of the given headers must have a table in enum_names.hpp
+listing exactly its enumerators (tables of dictionary enumerations are
+generated by dict2hpp.py).
+
+usage: enum_names.py <enum_names.hpp> <header.hpp>...
+"""
+
+import argparse
+import re
+import sys
+
+ENUM = re.compile(r'enum\s+class\s+(\w+)\s*:\s*uint32_t\s*\{(.*?)\};', re.S)
+ITEM = re.compile(r'^\s*(\w+)\s*=', re.M)
+TABLE = re.compile(r'struct\s+enum_names<(\w+)>\s*\{(.*?)\};', re.S)
+ENTRY = re.compile(r'DIAMETER_ENUM_ENTRY\((\w+)\)')
+
+
+def strip_comments(text):
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='check of enumeration name tables')
+    ap.add_argument('names')
+    ap.add_argument('headers', nargs='+')
+    args = ap.parse_args()
+
+    enums = {}
+    for hdr in args.headers:
+        with open(hdr) as f:
+            for name, body in ENUM.findall(strip_comments(f.read())):
+                enums[name] = ITEM.findall(body)
+
+    with open(args.names) as f:
+        tables = {name: ENTRY.findall(body) for name, body in TABLE.findall(strip_comments(f.read()))}
+
+    errors = []
+    for name, items in sorted(enums.items()):
+        if name not in tables:
+            errors.append('no table of ' + name)
+            continue
+        missing = [i for i in items if i not in tables[name]]
+        unknown = [i for i in tables[name] if i not in items]
+        if missing:
+            errors.append('{} misses {}'.format(name, ', '.join(missing)))
+        if unknown:
+            errors.append('{} has unknown {}'.format(name, ', '.join(unknown)))
+        if len(set(tables[name])) != len(tables[name]):
+            errors.append('{} has duplicates'.format(name))
+    for name in sorted(set(tables) - set(enums)):
+        errors.append('table of unknown enumeration ' + name)
+
+    if errors:
+        sys.exit('{} is out of sync:\n  {}'.format(args.names, '\n  '.join(errors)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,363 @@
+/**
+@file
+load generator: N connections to a peer, CER/CEA then DWR, STR or ACR
+at a given rate (or as fast as possible) with a window of outstanding requests
+
+usage: diameter_loadgen [-h host] [-p port] [-c connections] [-n requests]
+	[-w window] [-r requests/s] [-t timeout-ms] [-m DWR|STR|ACR]
+	[-o origin-host] [-R origin-realm] [-d destination-realm]
+	requests not answered within timeout (5000 ms by default) are counted as failed
+	latency at given rate is measured from the scheduled send time
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+#include "diameter/clock.hpp"
+#include "diameter/codec.hpp"
+#include "diameter/metrics.hpp"
+#include "diameter/text.hpp"
+#include "diameter/writer.hpp"
+
+#include "peer.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+using diameter::tool::connection;
+
+enum class MESSAGE : uint8_t { DWR, STR, ACR };
+
+//RFC6733 Diameter Base Accounting
+constexpr uint32_t BASE_ACCOUNTING = 3;
+
+struct config
+{
+	char const*      host;
+	char const*      port;
+	std::size_t      connections;
+	uint64_t         requests;   //total
+	std::size_t      window;     //outstanding per connection
+	uint64_t         rate;       //total per second, 0 - as fast as possible
+	uint64_t         timeout;    //of answer in ns
+	MESSAGE          message;
+	std::string_view origin_host;
+	std::string_view origin_realm;
+	std::string_view destination_realm;
+};
+
+struct result
+{
+	diameter::histogram latency; //ns
+	uint64_t            sent{0};
+	uint64_t            answered{0};
+	uint64_t            failed{0}; //answers w/o 2xxx Result-Code and timeouts
+	uint64_t            timeouts{0};
+	bool                error{false};
+};
+
+uint64_t now_ns()
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//Result-Code of answer or 0 if none or invalid
+uint32_t result_code(uint8_t const* data, std::size_t size)
+{
+	diameter::avp_reader reader{data + diameter::header_view::SIZE, size - diameter::header_view::SIZE};
+	diameter::avp_view avp;
+	while (reader.next(avp))
+	{
+		if (avp.code == diameter::result_code::id && !avp.vendor)
+		{
+			uint32_t code;
+			return avp.get(code) ? code : 0;
+		}
+	}
+	return 0;
+}
+
+//by diameter::base and the precompiled codec
+bool exchange_capabilities(connection& conn, config const& cfg, uint32_t id)
+{
+	std::size_t alloc_buf[256];
+	med::allocator alloc{alloc_buf};
+
+	diameter::base dia;
+	diameter::CER& cer = dia.select();
+	dia.header().ap_id(0);
+	dia.header().hop_id(id);
+	dia.header().end_id(id);
+	cer.ref<diameter::origin_host>().set(cfg.origin_host);
+	cer.ref<diameter::origin_realm>().set(cfg.origin_realm);
+	uint8_t const loopback[] = {127, 0, 0, 1};
+	cer.ref<diameter::host_ip_address>().push_back(alloc)->set(sizeof(loopback), loopback);
+	cer.ref<diameter::vendor_id>().set(diameter::VENDOR::NONE);
+	cer.ref<diameter::product_name>().set("diameter_loadgen"sv);
+	cer.ref<diameter::auth_application_id>().push_back(alloc)->set(diameter::APPLICATION::NONE);
+	cer.ref<diameter::acct_application_id>().push_back(alloc)->set(static_cast<diameter::APPLICATION>(BASE_ACCOUNTING));
+
+	uint8_t* out = conn.prepare(connection::MAX_MESSAGE);
+	conn.commit(diameter::codec::encode(dia, out, connection::MAX_MESSAGE));
+	if (!conn.flush()) { return false; }
+
+	bool done = false, accepted = false;
+	while (!done)
+	{
+		bool const ok = conn.receive([&](uint8_t const* data, std::size_t size)
+		{
+			diameter::base ans;
+			std::size_t ans_buf[256];
+			med::allocator ans_alloc{ans_buf};
+			if (done || !diameter::codec::try_decode(ans, data, size, ans_alloc)) { return; }
+			if (diameter::CEA const* cea = ans.cselect())
+			{
+				done = true;
+				accepted = cea->get<diameter::result_code>().is_accepted();
+			}
+		});
+		if (!ok) { return false; }
+	}
+	return accepted;
+}
+
+//request by direct writer
+std::size_t build_request(uint8_t* buf, std::size_t size, config const& cfg, std::size_t conn, uint64_t seq, uint32_t hop)
+{
+	diameter::avp_writer w{buf, size};
+	uint32_t const end = uint32_t(seq);
+
+	char sid_buf[128];
+	diameter::text::sink sid{sid_buf, sizeof(sid_buf)};
+	sid.put(cfg.origin_host);
+	sid.put(';');
+	sid.number(conn);
+	sid.put(';');
+	sid.number(seq);
+
+	switch (cfg.message)
+	{
+	case MESSAGE::DWR:
+		w.header(diameter::REQUEST | diameter::DWR::code, 0, hop, end);
+		w.add<diameter::origin_host>(cfg.origin_host);
+		w.add<diameter::origin_realm>(cfg.origin_realm);
+		break;
+
+	case MESSAGE::STR:
+		w.header(diameter::REQUEST | diameter::STR::code, 0, hop, end, diameter::cmd_flags::P);
+		w.add<diameter::session_id>(sid.str());
+		w.add<diameter::origin_host>(cfg.origin_host);
+		w.add<diameter::origin_realm>(cfg.origin_realm);
+		w.add<diameter::destination_realm>(cfg.destination_realm);
+		w.add<diameter::auth_application_id>(diameter::APPLICATION::NONE);
+		w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+		break;
+
+	case MESSAGE::ACR:
+	{
+		w.header(diameter::REQUEST | diameter::ACR::code, BASE_ACCOUNTING, hop, end, diameter::cmd_flags::P);
+		w.add<diameter::session_id>(sid.str());
+		w.add<diameter::origin_host>(cfg.origin_host);
+		w.add<diameter::origin_realm>(cfg.origin_realm);
+		w.add<diameter::destination_realm>(cfg.destination_realm);
+		w.add<diameter::acct_record_type>(diameter::ACCT_RECORD_TYPE::EVENT_RECORD);
+		w.add<diameter::acct_record_number>(uint32_t(seq));
+		w.add<diameter::acct_application_id>(BASE_ACCOUNTING);
+		uint8_t ts[4];
+		diameter::detail::put_be32(ts, diameter::coarse_clock::ntp());
+		w.add<diameter::event_timestamp>(ts, sizeof(ts));
+		break;
+	}
+	}
+	return w.finish();
+}
+
+void run(config const& cfg, std::size_t index, uint64_t count, result& res)
+{
+	int const fd = diameter::tool::connect_to(cfg.host, cfg.port);
+	if (fd < 0)
+	{
+		res.error = true;
+		return;
+	}
+	connection conn{fd};
+	if (!exchange_capabilities(conn, cfg, uint32_t(index)))
+	{
+		std::fprintf(stderr, "connection %zu: CER/CEA failed\n", index);
+		res.error = true;
+		return;
+	}
+
+	//outstanding request: hop-by-hop id is generation << 16 | slot
+	struct slot
+	{
+		uint32_t hop{0};
+		uint64_t sent{0};      //0 if free
+		uint64_t scheduled{0}; //latency is measured from
+	};
+	std::vector<slot> slots(cfg.window);
+	std::vector<uint16_t> free_slots;
+	for (std::size_t i = cfg.window; i > 0; --i) { free_slots.push_back(uint16_t(i - 1)); }
+	uint32_t generation = 0;
+	//hop-by-hop ids in order of sending, i.e. of their deadlines (answered ones are skipped)
+	std::deque<uint32_t> pending;
+	auto const outstanding = [&](uint32_t hop) -> slot*
+	{
+		auto& s = slots[hop & 0xFFFF];
+		return (s.hop == hop && s.sent) ? &s : nullptr;
+	};
+	auto const release = [&](slot& s)
+	{
+		s.sent = 0;
+		free_slots.push_back(uint16_t(&s - slots.data()));
+	};
+
+	uint64_t const interval = cfg.rate ? (1'000'000'000ULL * cfg.connections / cfg.rate) : 0;
+	uint64_t next = now_ns();
+
+	auto const on_answer = [&](uint8_t const* data, std::size_t size)
+	{
+		diameter::header_view hdr;
+		if (!hdr.parse(data, size) || hdr.request()) { return; }
+		if ((hdr.hop_id & 0xFFFF) >= slots.size()) { return; }
+		slot* s = outstanding(hdr.hop_id);
+		if (!s) { return; }
+
+		res.latency.record(now_ns() - s->scheduled);
+		++res.answered;
+		if (!diameter::is_success(static_cast<diameter::RESULT>(result_code(data, size)))) { ++res.failed; }
+		release(*s);
+	};
+
+	while (res.answered + res.timeouts < count)
+	{
+		uint64_t t = now_ns();
+		while (res.sent < count && !free_slots.empty() && (!interval || t >= next))
+		{
+			uint16_t const idx = free_slots.back();
+			free_slots.pop_back();
+			uint32_t const hop = (++generation << 16) | idx;
+			uint8_t* out = conn.prepare(1024);
+			conn.commit(build_request(out, 1024, cfg, index, res.sent, hop));
+			//scheduled time at given rate not to hide the delay of sending (coordinated omission)
+			slots[idx] = slot{hop, t, interval ? next : t};
+			pending.push_back(hop);
+			++res.sent;
+			next += interval;
+		}
+		if (!conn.flush())
+		{
+			res.error = true;
+			return;
+		}
+
+		//lost answers
+		t = now_ns();
+		while (!pending.empty())
+		{
+			slot* s = outstanding(pending.front());
+			if (s && s->sent + cfg.timeout > t) { break; }
+			if (s)
+			{
+				++res.timeouts;
+				++res.failed;
+				release(*s);
+			}
+			pending.pop_front();
+		}
+
+		//wait for answers up to the time of next request or the earliest timeout
+		uint64_t until = pending.empty() ? t + cfg.timeout : outstanding(pending.front())->sent + cfg.timeout;
+		if (interval && res.sent < count && !free_slots.empty() && next < until) { until = next; }
+		int const wait_ms = (until > t) ? int((until - t + 999'999) / 1'000'000) : 0;
+		pollfd pfd{conn.fd(), POLLIN, 0};
+		if (::poll(&pfd, 1, wait_ms) <= 0) { continue; }
+		if (!conn.receive(on_answer))
+		{
+			res.error = true;
+			return;
+		}
+	}
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	using diameter::tool::option;
+
+	config cfg;
+	cfg.host = option(argc, argv, "-h", "127.0.0.1");
+	cfg.port = option(argc, argv, "-p", "3868");
+	cfg.connections = std::strtoul(option(argc, argv, "-c", "1"), nullptr, 10);
+	cfg.requests = std::strtoull(option(argc, argv, "-n", "100000"), nullptr, 10);
+	cfg.window = std::strtoul(option(argc, argv, "-w", "16"), nullptr, 10);
+	cfg.rate = std::strtoull(option(argc, argv, "-r", "0"), nullptr, 10);
+	cfg.timeout = std::strtoull(option(argc, argv, "-t", "5000"), nullptr, 10) * 1'000'000;
+	cfg.origin_host = option(argc, argv, "-o", "loadgen.example.net");
+	cfg.origin_realm = option(argc, argv, "-R", "example.net");
+	cfg.destination_realm = option(argc, argv, "-d", "example.net");
+
+	std::string_view const msg = option(argc, argv, "-m", "DWR");
+	if (msg == "DWR") { cfg.message = MESSAGE::DWR; }
+	else if (msg == "STR") { cfg.message = MESSAGE::STR; }
+	else if (msg == "ACR") { cfg.message = MESSAGE::ACR; }
+	else
+	{
+		std::fprintf(stderr, "unsupported message: %s (DWR, STR or ACR)\n", msg.data());
+		return 1;
+	}
+	if (!cfg.connections || !cfg.window || cfg.window > 0x10000 || !cfg.timeout)
+	{
+		std::fprintf(stderr, "connections and timeout must be > 0 and window in [1..65536]\n");
+		return 1;
+	}
+
+	//Event-Timestamp of ACR
+	diameter::coarse_clock::updater clock;
+	std::vector<std::unique_ptr<result>> results;
+	std::vector<std::thread> threads;
+	auto const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < cfg.connections; ++i)
+	{
+		uint64_t const count = cfg.requests / cfg.connections + (i < cfg.requests % cfg.connections ? 1 : 0);
+		results.push_back(std::make_unique<result>());
+		threads.emplace_back(run, std::cref(cfg), i, count, std::ref(*results.back()));
+	}
+	for (auto& t : threads) { t.join(); }
+	double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	auto total = std::make_unique<result>();
+	bool error = false;
+	for (auto const& r : results)
+	{
+		total->latency.merge(r->latency);
+		total->sent += r->sent;
+		total->answered += r->answered;
+		total->failed += r->failed;
+		total->timeouts += r->timeouts;
+		error |= r->error;
+	}
+
+	std::printf("%s x %" PRIu64 " over %zu connections (window %zu): %.3f s, %.0f answers/s\n"
+		, msg.data(), total->answered, cfg.connections, cfg.window, seconds, double(total->answered) / seconds);
+	std::printf("latency us: p50=%.1f p99=%.1f p999=%.1f\n"
+		, double(total->latency.quantile(0.5)) / 1000
+		, double(total->latency.quantile(0.99)) / 1000
+		, double(total->latency.quantile(0.999)) / 1000);
+	if (total->failed) { std::printf("failed: %" PRIu64 " (timeouts: %" PRIu64 ")\n", total->failed, total->timeouts); }
+	return (error || total->failed) ? 1 : 0;
+}
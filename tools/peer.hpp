@@ -0,0 +1,189 @@
+#pragma once
+/**
+@file
+TCP framing of DIAMETER messages shared by diameter_loadgen and diameter_responder
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "diameter/scan.hpp"
+
+namespace diameter::tool {
+
+inline void no_delay(int fd)
+{
+	int const on = 1;
+	::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+//connected socket or -1
+inline int connect_to(char const* host, char const* port)
+{
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* res = nullptr;
+	if (int const rc = ::getaddrinfo(host, port, &hints, &res); rc != 0)
+	{
+		std::fprintf(stderr, "%s:%s: %s\n", host, port, ::gai_strerror(rc));
+		return -1;
+	}
+
+	int fd = -1;
+	for (addrinfo* ai = res; ai; ai = ai->ai_next)
+	{
+		fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (fd < 0) { continue; }
+		if (0 == ::connect(fd, ai->ai_addr, ai->ai_addrlen)) { break; }
+		::close(fd);
+		fd = -1;
+	}
+	::freeaddrinfo(res);
+	if (fd < 0) { std::fprintf(stderr, "connect %s:%s: %s\n", host, port, std::strerror(errno)); }
+	else { no_delay(fd); }
+	return fd;
+}
+
+//listening socket or -1
+inline int listen_on(char const* port)
+{
+	int const fd = ::socket(AF_INET6, SOCK_STREAM, 0);
+	if (fd < 0) { return -1; }
+	int const on = 1;
+	int const off = 0;
+	::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+
+	sockaddr_in6 addr{};
+	addr.sin6_family = AF_INET6;
+	addr.sin6_addr = in6addr_any;
+	addr.sin6_port = htons(uint16_t(std::atoi(port)));
+	if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) || ::listen(fd, 128))
+	{
+		std::fprintf(stderr, "listen on %s: %s\n", port, std::strerror(errno));
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/*
+Stream of DIAMETER messages over connected socket: complete messages are
+passed to the handler straight from the receive buffer, outgoing ones are
+appended to the transmit buffer and sent by flush() in one write.
+*/
+class connection
+{
+public:
+	static constexpr std::size_t MAX_MESSAGE = 64 * 1024;
+
+	explicit connection(int fd)
+		: m_fd{fd}, m_rx(2 * MAX_MESSAGE)
+	{
+		m_tx.reserve(MAX_MESSAGE);
+	}
+
+	~connection()                           { if (m_fd >= 0) { ::close(m_fd); } }
+
+	connection(connection const&) = delete;
+	connection& operator=(connection const&) = delete;
+
+	int fd() const                          { return m_fd; }
+
+	//space for outgoing message of up to size bytes, commit(n) to make it part of output
+	uint8_t* prepare(std::size_t size)
+	{
+		m_tx.resize(m_pending + size);
+		return m_tx.data() + m_pending;
+	}
+	void commit(std::size_t size)           { m_pending += size; }
+
+	void send(void const* data, std::size_t size)
+	{
+		std::memcpy(prepare(size), data, size);
+		commit(size);
+	}
+
+	//sends all committed messages, false on error
+	bool flush()
+	{
+		std::size_t sent = 0;
+		while (sent < m_pending)
+		{
+			ssize_t const n = ::send(m_fd, m_tx.data() + sent, m_pending - sent, MSG_NOSIGNAL);
+			if (n < 0)
+			{
+				if (errno == EINTR) { continue; }
+				return false;
+			}
+			sent += std::size_t(n);
+		}
+		m_pending = 0;
+		return true;
+	}
+
+	/*
+	Receives once (blocking) and calls func(uint8_t const* data, std::size_t size)
+	for each complete message. False on close, error or malformed header.
+	*/
+	template <class FUNC>
+	bool receive(FUNC&& func)
+	{
+		ssize_t n;
+		do { n = ::recv(m_fd, m_rx.data() + m_used, m_rx.size() - m_used, 0); } while (n < 0 && errno == EINTR);
+		if (n <= 0) { return false; }
+		m_used += std::size_t(n);
+
+		std::size_t pos = 0;
+		while (m_used - pos >= header_view::SIZE)
+		{
+			header_view hdr;
+			if (!hdr.parse(m_rx.data() + pos, m_used - pos) || hdr.length > MAX_MESSAGE) { return false; }
+			if (hdr.length > m_used - pos) { break; }
+			func(m_rx.data() + pos, std::size_t(hdr.length));
+			pos += hdr.length;
+		}
+		//keep partial message at the start
+		if (pos)
+		{
+			std::memmove(m_rx.data(), m_rx.data() + pos, m_used - pos);
+			m_used -= pos;
+		}
+		return true;
+	}
+
+private:
+	int                  m_fd;
+	std::vector<uint8_t> m_rx;
+	std::size_t          m_used{0};
+	std::vector<uint8_t> m_tx;
+	std::size_t          m_pending{0};
+};
+
+//value of -x option or default
+inline char const* option(int argc, char** argv, std::string_view name, char const* def)
+{
+	for (int i = 1; i + 1 < argc; ++i)
+	{
+		if (name == argv[i]) { return argv[i + 1]; }
+	}
+	return def;
+}
+
+}	//end: namespace diameter::tool
@@ -0,0 +1,217 @@
+/**
+@file
+stand-in peer answering CER with CEA, DWR with DWA, DPR with DPA
+and any other request with the given Result-Code (one thread per connection)
+
+usage: diameter_responder [-p port] [-r result-code] [-o origin-host] [-R origin-realm]
+	result-code is a number (e.g. 2001) or name (e.g. SUCCESS, UNABLE_TO_COMPLY)
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+
+#include <sys/socket.h>
+
+#include "diameter/codec.hpp"
+#include "diameter/enum_names.hpp"
+#include "diameter/writer.hpp"
+
+#include "peer.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+using diameter::tool::connection;
+
+struct config
+{
+	uint32_t         result;
+	std::string_view origin_host;
+	std::string_view origin_realm;
+};
+
+//copied from request to answer after Result-Code, Origin-Host and Origin-Realm
+bool echoed(diameter::avp_view const& avp)
+{
+	if (avp.vendor) { return false; }
+	switch (avp.code)
+	{
+	case diameter::auth_application_id::id:
+	case diameter::acct_application_id::id:
+	case diameter::acct_record_type::id:
+	case diameter::acct_record_number::id:
+	case diameter::proxy_info::id:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void put_result(diameter::avp_writer& w, config const& cfg, diameter::RESULT result)
+{
+	w.add<diameter::result_code>(result);
+	w.add<diameter::origin_host>(cfg.origin_host);
+	w.add<diameter::origin_realm>(cfg.origin_realm);
+}
+
+//offending AVP as is or header of the missing one
+void put_failed(diameter::avp_writer& w, diameter::decode_status const& status, uint8_t const* data)
+{
+	if (status.length)
+	{
+		w.add<diameter::failed_avp>(data + status.offset, status.length);
+	}
+	else if (status.avp_code)
+	{
+		uint8_t missing[8] = {};
+		diameter::detail::put_be32(missing, status.avp_code);
+		missing[7] = sizeof(missing);
+		w.add<diameter::failed_avp>(missing, sizeof(missing));
+	}
+}
+
+//CEA advertising the applications of CER (validated by the precompiled codec)
+std::size_t answer_cer(diameter::header_view const& hdr, uint8_t const* data, uint8_t* out, std::size_t size, config const& cfg)
+{
+	std::size_t alloc_buf[512];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	auto const status = diameter::codec::try_decode(dia, data, hdr.length, alloc);
+
+	diameter::avp_writer w{out, size};
+	w.header(diameter::CEA::code, hdr.app_id, hdr.hop_id, hdr.end_id
+		, diameter::is_protocol_error(status.result) ? diameter::cmd_flags::E : 0);
+	put_result(w, cfg, status.result);
+	uint8_t const loopback[] = {127, 0, 0, 1};
+	w.add<diameter::host_ip_address>(diameter::ip_address{loopback, sizeof(loopback)});
+	w.add<diameter::vendor_id>(diameter::VENDOR::NONE);
+	w.add<diameter::product_name>("diameter_responder"sv);
+	if (!status)
+	{
+		put_failed(w, status, data);
+	}
+	else
+	{
+		diameter::avp_reader reader{data + diameter::header_view::SIZE, hdr.length - diameter::header_view::SIZE};
+		diameter::avp_view avp;
+		while (reader.next(avp))
+		{
+			if (!avp.vendor && (avp.code == diameter::supported_vendor_id::id
+				|| avp.code == diameter::auth_application_id::id
+				|| avp.code == diameter::acct_application_id::id
+				|| avp.code == diameter::vendor_specific_application_id::id))
+			{
+				w.copy(avp);
+			}
+		}
+	}
+	return w.finish();
+}
+
+//answer with same code, application and ids: Session-Id, Result-Code, Origin-Host/Realm and echoed AVPs
+std::size_t answer(diameter::header_view const& hdr, uint8_t const* data, uint8_t* out, std::size_t size, config const& cfg, diameter::RESULT result)
+{
+	diameter::avp_writer w{out, size};
+	w.header(hdr.code, hdr.app_id, hdr.hop_id, hdr.end_id
+		, (hdr.flags & diameter::cmd_flags::P) | (diameter::is_protocol_error(result) ? diameter::cmd_flags::E : 0));
+
+	diameter::partial<diameter::session_id> sid;
+	if (sid.decode(data, hdr.length) && sid.get<diameter::session_id>())
+	{
+		w.copy(*sid.get<diameter::session_id>());
+	}
+	put_result(w, cfg, result);
+
+	diameter::avp_reader reader{data + diameter::header_view::SIZE, hdr.length - diameter::header_view::SIZE};
+	diameter::avp_view avp;
+	while (reader.next(avp))
+	{
+		if (echoed(avp)) { w.copy(avp); }
+	}
+	return w.finish();
+}
+
+void serve(int fd, config const& cfg)
+{
+	connection conn{fd};
+	bool closing = false;
+	auto const on_message = [&](uint8_t const* data, std::size_t size)
+	{
+		diameter::header_view hdr;
+		if (!hdr.parse(data, size) || !hdr.request()) { return; }
+
+		uint8_t* out = conn.prepare(connection::MAX_MESSAGE);
+		std::size_t len;
+		switch (hdr.code)
+		{
+		case diameter::CER::code:
+			len = answer_cer(hdr, data, out, connection::MAX_MESSAGE, cfg);
+			break;
+		case diameter::DWR::code:
+			len = answer(hdr, data, out, connection::MAX_MESSAGE, cfg, diameter::RESULT::SUCCESS);
+			break;
+		case diameter::DPR::code:
+			len = answer(hdr, data, out, connection::MAX_MESSAGE, cfg, diameter::RESULT::SUCCESS);
+			closing = true;
+			break;
+		default: //any_request
+			len = answer(hdr, data, out, connection::MAX_MESSAGE, cfg, static_cast<diameter::RESULT>(cfg.result));
+			break;
+		}
+		conn.commit(len);
+	};
+
+	//answers to all requests of one receive are sent together
+	while (!closing && conn.receive(on_message) && conn.flush()) {}
+	conn.flush();
+}
+
+} //end: namespace
+
+int main(int argc, char** argv)
+{
+	using diameter::tool::option;
+
+	config cfg;
+	cfg.origin_host = option(argc, argv, "-o", "responder.example.net");
+	cfg.origin_realm = option(argc, argv, "-R", "example.net");
+
+	std::string_view const result = option(argc, argv, "-r", "SUCCESS");
+	if (auto const res = diameter::enum_value<diameter::RESULT>(result))
+	{
+		cfg.result = static_cast<uint32_t>(*res);
+	}
+	else
+	{
+		char* end;
+		cfg.result = uint32_t(std::strtoul(result.data(), &end, 10));
+		if (*end || !cfg.result)
+		{
+			std::fprintf(stderr, "unknown result code: %s\n", result.data());
+			return 1;
+		}
+	}
+
+	char const* port = option(argc, argv, "-p", "3868");
+	int const lfd = diameter::tool::listen_on(port);
+	if (lfd < 0) { return 1; }
+
+	for (;;)
+	{
+		int const fd = ::accept(lfd, nullptr, nullptr);
+		if (fd < 0)
+		{
+			if (errno == EINTR) { continue; }
+			std::fprintf(stderr, "accept: %s\n", std::strerror(errno));
+			return 1;
+		}
+		diameter::tool::no_delay(fd);
+		std::thread{serve, fd, std::cref(cfg)}.detach();
+	}
+}
@@ -0,0 +1,49 @@
+#include "diameter/clock.hpp"
+
+#include "ut.hpp"
+
+TEST(clock, ntp)
+{
+	using namespace diameter;
+	static_assert(unix_to_ntp(0) == NTP_UNIX_OFFSET);
+	static_assert(ntp_to_unix(NTP_UNIX_OFFSET) == 0);
+	//2018-01-01
+	static_assert(ntp_to_unix(unix_to_ntp(1514764800)) == 1514764800);
+	//NTP era 1 starts at 2036-02-07 06:28:16
+	static_assert(unix_to_ntp(2085978496) == 0);
+	static_assert(ntp_to_unix(unix_to_ntp(2085978496 + 3600)) == 2085978496 + 3600);
+}
+
+TEST(clock, coarse)
+{
+	using namespace diameter;
+	auto const sys = uint64_t(std::chrono::duration_cast<std::chrono::seconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+	//system clock without updater
+	EXPECT_LE(sys, coarse_clock::seconds());
+
+	{
+		coarse_clock::updater updater{std::chrono::milliseconds{1}};
+		auto const before = coarse_clock::now();
+		EXPECT_LE(sys, before / 1000000000u);
+		std::this_thread::sleep_for(std::chrono::milliseconds{20});
+		EXPECT_LT(before, coarse_clock::now());
+		EXPECT_EQ(unix_to_ntp(coarse_clock::seconds()), coarse_clock::ntp());
+	}
+	//ticked time isn't used without updater
+	auto const ticked = coarse_clock::tick();
+	std::this_thread::sleep_for(std::chrono::milliseconds{2});
+	EXPECT_LT(ticked, coarse_clock::now());
+}
+
+TEST(clock, manual)
+{
+	using namespace diameter;
+	coarse_clock::manual scope;
+	//time of the last tick until the next one
+	auto const ticked = coarse_clock::tick();
+	std::this_thread::sleep_for(std::chrono::milliseconds{2});
+	EXPECT_EQ(ticked, coarse_clock::now());
+	EXPECT_LT(ticked, coarse_clock::tick());
+	EXPECT_LT(ticked, coarse_clock::now());
+}
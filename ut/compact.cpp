@@ -0,0 +1,45 @@
+#include <string_view>
+
+#include "diameter/base.hpp"
+#include "diameter/compact.hpp"
+
+#include "ut.hpp"
+#include "str.hpp"
+
+using namespace std::string_view_literals;
+
+TEST(compact, str)
+{
+	diameter::compact<diameter::STR> msg;
+	ASSERT_TRUE(msg.assign(str_encoded, sizeof(str_encoded)));
+	EXPECT_EQ(275, msg.header().code);
+
+	EXPECT_FALSE(msg.has<diameter::user_name>());
+	EXPECT_FALSE(msg.get<diameter::user_name>());
+	auto const sid = msg.get<diameter::session_id>();
+	ASSERT_TRUE(sid);
+	EXPECT_EQ("host;1;2"sv, sid->str());
+	auto const host = msg.get<diameter::destination_host>();
+	ASSERT_TRUE(host);
+	EXPECT_EQ("Dest.Host"sv, host->str());
+
+	//unknown AVPs are kept as any_avp
+	std::size_t vendor_avps = 0;
+	msg.for_each<diameter::any_avp>([&](diameter::avp_view const& avp)
+	{
+		vendor_avps += (avp.vendor == uint32_t(diameter::VENDOR::TGPP));
+	});
+	EXPECT_EQ(1, vendor_avps);
+
+	//only present AVPs with their index take memory
+	EXPECT_GE(msg.footprint(), sizeof(msg) + sizeof(str_encoded) - 20);
+	EXPECT_LT(msg.footprint(), sizeof(msg) + sizeof(str_encoded) - 20 + 16 * sizeof(uint16_t));
+
+	EXPECT_FALSE(msg.assign(str_encoded, sizeof(str_encoded) - 4));
+	EXPECT_FALSE(msg.has<diameter::session_id>());
+
+	//slab of previous message is reused
+	ASSERT_TRUE(msg.assign(str_encoded, sizeof(str_encoded)));
+	ASSERT_TRUE(msg.get<diameter::destination_host>());
+	EXPECT_EQ("Dest.Host"sv, msg.get<diameter::destination_host>()->str());
+}
@@ -9,6 +9,9 @@
 #include "med/decode.hpp"
 
 #include "diameter/base.hpp"
+#include "diameter/codec.hpp"
+#include "diameter/format.hpp"
+#include "diameter/writer.hpp"
 
 #include "ut.hpp"
 
@@ -503,6 +506,51 @@ TEST(encode, cea)
 	EXPECT_TRUE(Matches(cea_encoded1, buffer));
 }
 
+TEST(encode, cea_writer)
+{
+	uint8_t buffer[1024];
+	diameter::avp_writer w{buffer, sizeof(buffer)};
+	w.header(diameter::CEA::code, 0, 0x22222222, 0x55555555);
+	w.add<diameter::result_code>(diameter::RESULT::SUCCESS);
+	w.add<diameter::origin_host>("Orig.Host"sv);
+	w.add<diameter::origin_realm>("orig.realm.net"sv);
+	w.add<diameter::host_ip_address>(diameter::ip_address{ip4, sizeof(ip4)});
+	w.add<diameter::vendor_id>(diameter::VENDOR::NONE);
+	w.add<diameter::product_name>("base:dia"sv);
+	w.add<diameter::supported_vendor_id>(diameter::VENDOR::TGPP);
+	w.add<diameter::supported_vendor_id>(diameter::VENDOR::NOKIA);
+	for (auto app : {diameter::APPLICATION::NONE, diameter::APPLICATION::S6A, diameter::APPLICATION::GX, diameter::APPLICATION::GXX})
+	{
+		w.add<diameter::auth_application_id>(app);
+	}
+	for (auto app : {diameter::APPLICATION::S6A, diameter::APPLICATION::GX, diameter::APPLICATION::GXX})
+	{
+		auto const id = w.begin_group<diameter::vendor_specific_application_id>();
+		w.add<diameter::vendor_id>(diameter::VENDOR::TGPP);
+		w.add<diameter::auth_application_id>(app);
+		w.end_group(id);
+	}
+	ASSERT_EQ(sizeof(cea_encoded1), w.finish());
+	EXPECT_TRUE(Matches(cea_encoded1, buffer));
+
+	//doesn't fit
+	diameter::avp_writer small{buffer, 32};
+	small.header(diameter::CEA::code, 0, 0x22222222, 0x55555555);
+	small.add<diameter::origin_realm>("orig.realm.net"sv);
+	EXPECT_FALSE(small.ok());
+	EXPECT_EQ(0, small.finish());
+
+	//copy of encoded AVPs as is
+	uint8_t copied[1024];
+	diameter::avp_writer wc{copied, sizeof(copied)};
+	wc.header(diameter::CEA::code, 0, 0x22222222, 0x55555555);
+	diameter::avp_reader reader{cea_encoded1 + diameter::header_view::SIZE, sizeof(cea_encoded1) - diameter::header_view::SIZE};
+	diameter::avp_view avp;
+	while (reader.next(avp)) { wc.copy(avp); }
+	ASSERT_EQ(sizeof(cea_encoded1), wc.finish());
+	EXPECT_TRUE(Matches(cea_encoded1, copied));
+}
+
 TEST(decode, cea)
 {
 	std::size_t alloc_buf[1024];
@@ -908,6 +956,195 @@ TEST(decode, ans_unknown)
 }
 #endif
 
+TEST(decode, lazy_grouped)
+{
+	std::size_t alloc_buf[1024];
+	med::allocator alloc{alloc_buf};
+
+	uint8_t encoded[1024];
+	std::size_t encoded_size = 0;
+	{
+		diameter::base dia;
+		diameter::STR& msg = dia.select();
+		dia.header().hop_id(0x22222222);
+		dia.header().end_id(0x55555555);
+
+		msg.ref<diameter::session_id>().set("Orig.Host");
+		msg.ref<diameter::origin_host>().set("Orig.Host"sv);
+		msg.ref<diameter::origin_realm>().set("orig.realm.net"sv);
+		msg.ref<diameter::destination_realm>().set("dest.realm.net"sv);
+		msg.ref<diameter::auth_application_id>().set(diameter::APPLICATION::GX);
+		msg.ref<diameter::termination_cause>().set(diameter::TERMINATION_CAUSE::LOGOUT);
+		auto* pi = msg.ref<diameter::proxy_info>().push_back(alloc);
+		pi->ref<diameter::proxy_host>().set("proxy.realm.net"sv);
+		pi->ref<diameter::proxy_state>().set("state"sv);
+
+		med::encoder_context<> ctx{encoded};
+		encode(med::octet_encoder{ctx}, dia);
+		encoded_size = ctx.buffer().get_offset();
+	}
+
+	diameter::base dia;
+	med::decoder_context<med::allocator> ctx{encoded, encoded_size, &alloc};
+	decode(med::octet_decoder{ctx}, dia);
+
+	diameter::STR const* msg = dia.cselect();
+	ASSERT_NE(nullptr, msg);
+	ASSERT_EQ(1, msg->count<diameter::proxy_info>());
+	auto const& pi = *msg->get<diameter::proxy_info>().begin();
+	EXPECT_FALSE(pi.expanded());
+	{
+		auto const exp = "proxy.realm.net"sv;
+		EXPECT_TRUE(Matches(exp, pi.get<diameter::proxy_host>()));
+	}
+	EXPECT_TRUE(pi.expanded());
+
+	//not modified grouped AVP is encoded back as is
+	uint8_t buffer[1024];
+	med::encoder_context<> ectx{buffer};
+	encode(med::octet_encoder{ectx}, dia);
+	ASSERT_EQ(encoded_size, ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(encoded, buffer, encoded_size));
+}
+
+TEST(decode, lazy_modify)
+{
+	uint8_t encoded[512];
+	diameter::avp_writer w{encoded, sizeof(encoded)};
+	w.header(diameter::REQUEST | diameter::STR::code, 0, 0x22222222, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("host;1;2"sv);
+	w.add<diameter::origin_host>("Orig.Host"sv);
+	w.add<diameter::origin_realm>("orig.realm.net"sv);
+	w.add<diameter::destination_realm>("dest.realm.net"sv);
+	w.add<diameter::auth_application_id>(diameter::APPLICATION::GX);
+	w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+	auto const group = w.begin_group<diameter::proxy_info>();
+	w.add<diameter::proxy_host>("proxy.realm.net"sv);
+	w.add<diameter::proxy_state>("state"sv);
+	w.end_group(group);
+	std::size_t const size = w.finish();
+
+	std::size_t alloc_buf[256];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	med::decoder_context<med::allocator> ctx{encoded, size, &alloc};
+	decode(med::octet_decoder{ctx}, dia);
+
+	//ref of one AVP in not expanded group keeps the others
+	diameter::STR& msg = dia.select();
+	auto& pi = *msg.ref<diameter::proxy_info>().begin();
+	ASSERT_FALSE(pi.expanded());
+	pi.ref<diameter::proxy_host>().set("proxy2.realm.net"sv);
+
+	uint8_t buffer[512];
+	med::encoder_context<> ectx{buffer};
+	encode(med::octet_encoder{ectx}, dia);
+
+	std::size_t alloc_buf2[256];
+	med::allocator alloc2{alloc_buf2};
+	diameter::base out;
+	med::decoder_context<med::allocator> dctx{buffer, ectx.buffer().get_offset(), &alloc2};
+	decode(med::octet_decoder{dctx}, out);
+	diameter::STR const* res = out.cselect();
+	ASSERT_NE(nullptr, res);
+	ASSERT_EQ(1, res->count<diameter::proxy_info>());
+	auto const& info = *res->get<diameter::proxy_info>().begin();
+	{
+		auto const exp = "proxy2.realm.net"sv;
+		EXPECT_TRUE(Matches(exp, info.get<diameter::proxy_host>()));
+	}
+	{
+		auto const exp = "state"sv;
+		EXPECT_TRUE(Matches(exp, info.get<diameter::proxy_state>()));
+	}
+}
+
+TEST(decode, lazy_invalid)
+{
+	//Proxy-Info without mandatory Proxy-State
+	uint8_t encoded[512];
+	diameter::avp_writer w{encoded, sizeof(encoded)};
+	w.header(diameter::REQUEST | diameter::STR::code, 0, 0x22222222, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("host;1;2"sv);
+	w.add<diameter::origin_host>("Orig.Host"sv);
+	w.add<diameter::origin_realm>("orig.realm.net"sv);
+	w.add<diameter::destination_realm>("dest.realm.net"sv);
+	w.add<diameter::auth_application_id>(diameter::APPLICATION::GX);
+	w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+	auto const pi = w.begin_group<diameter::proxy_info>();
+	w.add<diameter::proxy_host>("proxy.realm.net"sv);
+	w.end_group(pi);
+	std::size_t const size = w.finish();
+
+	std::size_t alloc_buf[256];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	ASSERT_TRUE(diameter::try_decode(dia, encoded, size, alloc));
+
+	diameter::STR const* msg = dia.cselect();
+	ASSERT_NE(nullptr, msg);
+	ASSERT_EQ(1, msg->count<diameter::proxy_info>());
+	auto const& info = *msg->get<diameter::proxy_info>().begin();
+	EXPECT_FALSE(info.expand(alloc));
+	EXPECT_FALSE(info.expanded());
+	EXPECT_EQ(0, info.count<diameter::proxy_host>());
+}
+
+TEST(format, cer)
+{
+	diameter::base dia;
+
+	std::size_t alloc_buf[1024];
+	med::allocator alloc{alloc_buf};
+	med::decoder_context<med::allocator> ctx{ cer_encoded1, &alloc};
+	decode(med::octet_decoder{ctx}, dia);
+
+	char buf[1024];
+	auto const txt = diameter::format(dia, buf, sizeof(buf));
+	EXPECT_EQ(0, txt.find("Capabilities-Exchange-Request(257) R... app=0 hop=0x22222222 end=0x55555555:"));
+	EXPECT_NE(txt.npos, txt.find(" Origin-Host=\"Orig.Host\""));
+	EXPECT_NE(txt.npos, txt.find(" Host-IP-Address=1.2.3.4"));
+	EXPECT_NE(txt.npos, txt.find(" Supported-Vendor-Id=10415 Supported-Vendor-Id=28458"));
+
+	auto const json = diameter::format(dia, buf, sizeof(buf), diameter::FORMAT::JSON);
+	EXPECT_EQ(0, json.find("{\"message\":\"Capabilities-Exchange-Request\",\"code\":257,"));
+	EXPECT_NE(json.npos, json.find("\"Supported-Vendor-Id\":[10415,28458]"));
+	EXPECT_EQ('}', json.back());
+
+	//truncated to the buffer
+	char small[16];
+	EXPECT_EQ(sizeof(small), diameter::format(dia, small, sizeof(small)).size());
+
+	char addr[48];
+	diameter::address ip;
+	uint8_t const ip6[16] = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+	ip.set(sizeof(ip6), ip6);
+	ip.print(addr);
+	EXPECT_STREQ("2001:db8::1", addr);
+}
+
+TEST(codec, cer)
+{
+	std::size_t alloc_buf[1024];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	diameter::codec::decode(dia, cer_encoded1, sizeof(cer_encoded1), alloc);
+	diameter::CER const* msg = dia.cselect();
+	ASSERT_NE(nullptr, msg);
+	//header by header_view
+	EXPECT_TRUE(dia.header().flags().request());
+	EXPECT_EQ(0, dia.header().ap_id());
+	EXPECT_EQ(0x22222222, dia.header().hop_id());
+	EXPECT_EQ(0x55555555, dia.header().end_id());
+
+	uint8_t buffer[1024];
+	EXPECT_EQ(sizeof(cer_encoded1), diameter::codec::encode(dia, buffer, sizeof(buffer)));
+	EXPECT_TRUE(Matches(cer_encoded1, buffer));
+
+	diameter::base bad;
+	EXPECT_EQ(diameter::RESULT::INVALID_MESSAGE_LENGTH, diameter::codec::try_decode(bad, cer_encoded1, 16, alloc).result);
+}
+
 int main(int argc, char **argv)
 {
 	::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,39 @@
+#include "diameter/duplicate.hpp"
+
+#include "ut.hpp"
+
+using namespace diameter;
+using namespace std::chrono_literals;
+
+TEST(duplicate, retransmission)
+{
+	duplicate_cache cache{2, 30s};
+	auto const now = duplicate_cache::clock::now();
+
+	EXPECT_EQ(nullptr, cache.check(0x55555555, "pgw.example.net", now));
+	//same id from another host is not a duplicate
+	EXPECT_EQ(nullptr, cache.check(0x55555555, "smf.example.net", now));
+
+	//still processed
+	auto const* rec = cache.check(0x55555555, "pgw.example.net", now + 1s);
+	ASSERT_NE(nullptr, rec);
+	EXPECT_TRUE(rec->answer.empty());
+
+	uint8_t const cca[] = {1, 0, 0, 20};
+	EXPECT_TRUE(cache.answer(0x55555555, "pgw.example.net", cca, sizeof(cca)));
+	rec = cache.check(0x55555555, "pgw.example.net", now + 2s);
+	ASSERT_NE(nullptr, rec);
+	ASSERT_EQ(sizeof(cca), rec->answer.size());
+	EXPECT_TRUE(Matches(cca, rec->answer.data(), sizeof(cca)));
+
+	//capacity: oldest evicted
+	EXPECT_EQ(nullptr, cache.check(1, "pgw.example.net", now + 3s));
+	EXPECT_EQ(2, cache.size());
+	EXPECT_EQ(nullptr, cache.check(0x55555555, "pgw.example.net", now + 4s));
+	EXPECT_FALSE(cache.answer(0x55555555, "smf.example.net", cca, sizeof(cca)));
+
+	//window
+	cache.expire(now + 40s);
+	EXPECT_EQ(0, cache.size());
+	EXPECT_EQ(nullptr, cache.check(1, "pgw.example.net", now + 40s));
+}
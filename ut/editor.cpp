@@ -0,0 +1,123 @@
+#include <string_view>
+
+#include "diameter/base.hpp"
+#include "diameter/editor.hpp"
+
+#include "ut.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+//request with given Destination-Host, Route-Records and hop-by-hop id
+std::size_t make_request(uint8_t (&buf)[512], std::string_view dest_host
+	, std::initializer_list<std::string_view> route_records, uint32_t hop = 0x22222222)
+{
+	diameter::avp_writer w{buf, sizeof(buf)};
+	w.header(diameter::REQUEST | diameter::STR::code, 0, hop, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("host;1;2"sv);
+	w.add<diameter::origin_host>("Orig.Host"sv);
+	w.add<diameter::origin_realm>("orig.realm.net"sv);
+	if (!dest_host.empty()) { w.add<diameter::destination_host>(dest_host); }
+	for (auto rr : route_records) { w.add<diameter::route_record>(rr); }
+	w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+	return w.finish();
+}
+
+} //end: namespace
+
+TEST(editor, unmodified)
+{
+	uint8_t original[512], out[512];
+	std::size_t const size = make_request(original, "hss1.example.net"sv, {"dra1"sv});
+
+	diameter::editor ed{original, size};
+	ASSERT_TRUE(ed.ok());
+	EXPECT_FALSE(ed.modified());
+	ASSERT_EQ(size, ed.encode(out, sizeof(out)));
+	EXPECT_TRUE(Matches(original, out, size));
+
+	EXPECT_FALSE(ed.assign(original, size - 1));
+	EXPECT_EQ(0, ed.encode(out, sizeof(out)));
+}
+
+TEST(editor, replace)
+{
+	uint8_t original[512], expected[512], out[512];
+	std::size_t const size = make_request(original, "hss1.example.net"sv, {"dra1"sv, "dra2"sv});
+
+	diameter::editor ed{original, size};
+	ed.set<diameter::destination_host>("hss2.long.example.net"sv);
+	ASSERT_TRUE(ed.modified());
+
+	std::size_t const exp_size = make_request(expected, "hss2.long.example.net"sv, {"dra1"sv, "dra2"sv});
+	ASSERT_EQ(exp_size, ed.encode(out, sizeof(out)));
+	EXPECT_TRUE(Matches(expected, out, exp_size));
+
+	//doesn't fit
+	EXPECT_EQ(0, ed.encode(out, exp_size - 4));
+}
+
+TEST(editor, remove_add)
+{
+	uint8_t original[512], expected[512], out[512];
+	std::size_t const size = make_request(original, "hss1.example.net"sv, {"dra1"sv, "dra2"sv});
+
+	diameter::editor ed{original, size};
+	ed.remove<diameter::route_record>();
+	ed.remove<diameter::destination_host>();
+	ed.hop_id(0x33333333);
+	ed.add<diameter::route_record>("dra3"sv);
+
+	diameter::avp_writer w{expected, sizeof(expected)};
+	w.header(diameter::REQUEST | diameter::STR::code, 0, 0x33333333, 0x55555555, diameter::cmd_flags::P);
+	w.add<diameter::session_id>("host;1;2"sv);
+	w.add<diameter::origin_host>("Orig.Host"sv);
+	w.add<diameter::origin_realm>("orig.realm.net"sv);
+	w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+	w.add<diameter::route_record>("dra3"sv);
+	std::size_t const exp_size = w.finish();
+
+	ASSERT_EQ(exp_size, ed.encode(out, sizeof(out)));
+	EXPECT_TRUE(Matches(expected, out, exp_size));
+}
+
+TEST(editor, set_absent)
+{
+	uint8_t original[512], out[512];
+	std::size_t const size = make_request(original, {}, {});
+
+	//added at the end
+	diameter::editor ed{original, size};
+	ed.set<diameter::destination_host>("hss1.example.net"sv);
+	std::size_t const out_size = ed.encode(out, sizeof(out));
+	ASSERT_EQ(size + 8 + 16, out_size);
+	EXPECT_TRUE(Matches(original + 20, out + 20, size - 20));
+
+	diameter::header_view hdr;
+	ASSERT_TRUE(hdr.parse(out, out_size));
+	EXPECT_EQ(out_size, hdr.length);
+	diameter::avp_reader reader{out + size, out_size - size};
+	diameter::avp_view avp;
+	ASSERT_TRUE(reader.next(avp));
+	EXPECT_EQ(diameter::destination_host::id, avp.code);
+	EXPECT_EQ("hss1.example.net"sv, avp.str());
+}
+
+TEST(editor, empty_edit)
+{
+	uint8_t original[512], out[512];
+	std::size_t const size = make_request(original, "hss1.example.net"sv, {"dra1"sv});
+
+	//AVP w/o any bytes to set
+	diameter::editor ed{original, size};
+	diameter::avp_view const empty{original + diameter::header_view::SIZE, diameter::destination_host::id, 0, 0, 0};
+	ed.set(empty);
+	EXPECT_FALSE(ed.ok());
+	EXPECT_EQ(0, ed.encode(out, sizeof(out)));
+
+	//removal has nothing to encode
+	ASSERT_TRUE(ed.assign(original, size));
+	ed.remove<diameter::route_record>();
+	EXPECT_TRUE(ed.ok());
+}
@@ -0,0 +1,64 @@
+#include "diameter/enum_names.hpp"
+#include "diameter/credit_control.hpp"
+#include "diameter/doic.hpp"
+
+#include "ut.hpp"
+
+using namespace std::string_view_literals;
+
+TEST(enums, names)
+{
+	using namespace diameter;
+	static_assert(enum_name(RESULT::TOO_BUSY) == "TOO_BUSY"sv);
+	static_assert(enum_value<RESULT>("TOO_BUSY") == RESULT::TOO_BUSY);
+
+	for (auto const& e : enum_names<RESULT>::entries)
+	{
+		EXPECT_EQ(e.name, enum_name(e.value));
+		EXPECT_EQ(e.value, enum_value<RESULT>(e.name));
+	}
+	for (auto const& e : enum_names<APPLICATION>::entries)
+	{
+		EXPECT_EQ(e.name, enum_name(e.value));
+		EXPECT_EQ(e.value, enum_value<APPLICATION>(e.name));
+	}
+
+	EXPECT_EQ("ERROR_USER_UNKNOWN"sv, enum_name(EXPERIMENTAL_RESULT::ERROR_USER_UNKNOWN));
+	EXPECT_EQ(""sv, enum_name(static_cast<RESULT>(2999)));
+	EXPECT_FALSE(enum_value<APPLICATION>("S6"));
+	EXPECT_FALSE(enum_value<APPLICATION>("s6a"));
+	//duplicate value resolves to the first name, both names are known
+	EXPECT_EQ("SUN"sv, enum_name(VENDOR::USR));
+	EXPECT_EQ(VENDOR::USR, enum_value<VENDOR>("USR"));
+}
+
+//tables of dictionary enumerations are generated with them
+TEST(enums, dictionary)
+{
+	using namespace diameter;
+	static_assert(enum_name(cc::CC_REQUEST_TYPE::UPDATE_REQUEST) == "UPDATE_REQUEST"sv);
+	static_assert(enum_value<cc::FINAL_UNIT_ACTION>("REDIRECT") == cc::FINAL_UNIT_ACTION::REDIRECT);
+	static_assert(enum_name(OC_REPORT_TYPE::REALM_REPORT) == "REALM_REPORT"sv);
+
+	for (auto const& e : enum_names<cc::CC_UNIT_TYPE>::entries)
+	{
+		EXPECT_EQ(e.name, enum_name(e.value));
+		EXPECT_EQ(e.value, enum_value<cc::CC_UNIT_TYPE>(e.name));
+	}
+	EXPECT_EQ(""sv, enum_name(static_cast<cc::CC_REQUEST_TYPE>(0)));
+}
+
+TEST(enums, result_class)
+{
+	using namespace diameter;
+	static_assert(is_informational(RESULT::MULTI_ROUND_AUTH));
+	static_assert(is_success(RESULT::LIMITED_SUCCESS));
+	static_assert(is_protocol_error(RESULT::REDIRECT_INDICATION));
+	static_assert(is_transient(RESULT::OUT_OF_SPACE));
+	static_assert(is_permanent(RESULT::MISSING_AVP));
+	static_assert(is_retriable(RESULT::TOO_BUSY) && is_retriable(RESULT::ELECTION_LOST));
+	static_assert(!is_retriable(RESULT::LOOP_DETECTED) && !is_retriable(RESULT::UNABLE_TO_COMPLY));
+	static_assert(!is_success(RESULT::ENCODE_SUCCESS) && !is_permanent(RESULT::ENCODE_FAILURE));
+	static_assert(is_transient(EXPERIMENTAL_RESULT::AUTHENTICATION_DATA_UNAVAILABLE));
+	static_assert(is_permanent(EXPERIMENTAL_RESULT::ERROR_USER_UNKNOWN));
+}
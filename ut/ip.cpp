@@ -0,0 +1,83 @@
+#include "diameter/base_avps.hpp"
+#include "diameter/ip.hpp"
+
+#include "ut.hpp"
+
+using diameter::ip_address;
+
+TEST(ip, parse)
+{
+	char buf[48];
+	for (auto const* text : {"1.2.3.4", "255.255.255.255", "0.0.0.0"
+		, "2001:db8::1", "::", "::1", "1::", "fe80::1:2:3:4", "1:2:3:4:5:6:7:8", "::ffff:1.2.3.4"})
+	{
+		auto const ip = ip_address::parse(text);
+		ASSERT_FALSE(ip.empty()) << text;
+		EXPECT_EQ(text, ip.print(buf, sizeof(buf)));
+	}
+
+	uint8_t const exp6[16] = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x0a, 0xbc, 0xde};
+	auto const ip = ip_address::parse("2001:DB8:0:0::a:BCDE");
+	ASSERT_TRUE(ip.is_v6());
+	EXPECT_TRUE(Matches(exp6, ip.data(), sizeof(exp6)));
+
+	for (auto const* text : {"", "1.2.3", "1.2.3.4.5", "256.1.1.1", "1..2.3", "1.2.3.4 ", "01.2.3.4"
+		, ":", ":1", "1:", "1:::2", "1::2::3", "12345::", "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7::8:9", "::1.2.3", "g::"})
+	{
+		EXPECT_TRUE(ip_address::parse(text).empty()) << text;
+	}
+}
+
+TEST(ip, list)
+{
+	diameter::ip_address_list<2> list;
+	EXPECT_TRUE(list.add(ip_address::parse("10.0.0.1")));
+	EXPECT_FALSE(list.add(ip_address{}));
+	EXPECT_TRUE(list.add(ip_address::parse("::1")));
+	EXPECT_FALSE(list.add(ip_address::parse("10.0.0.2")));
+	EXPECT_EQ(2, list.size());
+
+	in_addr v4;
+	v4.s_addr = htonl(0x0A000001);
+	EXPECT_TRUE(list.contains(ip_address{v4}));
+	EXPECT_TRUE(list.contains(ip_address::parse("0:0::1")));
+	EXPECT_FALSE(list.contains(ip_address::parse("10.0.0.2")));
+	//IPv4 vs IPv4-mapped IPv6
+	EXPECT_FALSE(list.contains(ip_address::parse("::ffff:10.0.0.1")));
+}
+
+TEST(ip, address)
+{
+	diameter::address addr;
+	EXPECT_TRUE(addr.parse("10.0.0.1"));
+	EXPECT_EQ(diameter::address::IPV4, addr.family());
+	EXPECT_EQ(ip_address::parse("10.0.0.1"), addr.compact());
+	in_addr v4;
+	ASSERT_TRUE(addr.get(v4));
+	EXPECT_EQ(htonl(0x0A000001), v4.s_addr);
+	in6_addr v6;
+	EXPECT_FALSE(addr.get(v6));
+
+	EXPECT_TRUE(addr.parse("2001:db8::1"));
+	EXPECT_EQ(diameter::address::IPV6, addr.family());
+	ASSERT_TRUE(addr.get(v6));
+	EXPECT_FALSE(addr.get(v4));
+	EXPECT_FALSE(addr.parse("10.0.0"));
+	EXPECT_EQ(ip_address::parse("2001:db8::1"), addr.compact());
+
+	//family and length don't match
+	EXPECT_TRUE(addr.parse("1.2.3.4"));
+	addr.data()[1] = diameter::address::IPV6;
+	EXPECT_TRUE(addr.compact().empty());
+
+	//Address AVPs
+	uint8_t const ip4[] = {1, 2, 3, 4};
+	diameter::host_ip_address avps[2];
+	avps[0].set(sizeof(ip4), ip4);
+	avps[1].set(ip_address::parse("::1"));
+	EXPECT_EQ(ip_address::parse("1.2.3.4"), avps[0].ip());
+	auto const peers = diameter::ip_address_list<4>::from(avps);
+	EXPECT_EQ(2, peers.size());
+	EXPECT_TRUE(peers.contains(ip_address::parse("1.2.3.4")));
+	EXPECT_TRUE(peers.contains(ip_address::parse("::1")));
+}
@@ -0,0 +1,71 @@
+#include <memory>
+#include <thread>
+
+#include "diameter/metrics.hpp"
+
+#include "ut.hpp"
+
+TEST(metrics, histogram)
+{
+	using diameter::histogram;
+	for (uint64_t v : {0ULL, 15ULL, 16ULL, 31ULL, 32ULL, 1000ULL, 123456789ULL})
+	{
+		auto const i = histogram::index(v);
+		EXPECT_LE(histogram::value(i), v);
+		EXPECT_GT(histogram::value(i + 1), v);
+	}
+	EXPECT_EQ(histogram::BUCKETS - 1, histogram::index(~0ULL));
+
+	auto h = std::make_unique<histogram>();
+	for (uint64_t v = 1; v <= 1000; ++v) { h->record(v * 1000); }
+	EXPECT_EQ(1000, h->count());
+	EXPECT_EQ(500500000, h->sum());
+	//within precision of bucket (1/16)
+	EXPECT_NEAR(500000, h->quantile(0.5), 500000 / 16);
+	EXPECT_NEAR(990000, h->quantile(0.99), 990000 / 16);
+	EXPECT_EQ(histogram::value(histogram::index(1000)), h->quantile(0));
+}
+
+TEST(metrics, dump)
+{
+	constexpr uint32_t REQUEST = 0x80000000;
+	diameter::metrics stats;
+	auto const namer = [](uint32_t tag) -> char const*
+	{
+		return tag == (REQUEST | 257) ? "Capabilities-Exchange-Request" : nullptr;
+	};
+
+	std::thread workers[2];
+	for (auto& w : workers)
+	{
+		w = std::thread{[&stats]
+		{
+			auto& shard = stats.add_shard();
+			for (uint64_t i = 0; i < 100; ++i)
+			{
+				auto& cer = shard.at(REQUEST | 257, 0);
+				cer.count(100);
+				cer.record(diameter::STAGE::DECODE, 200);
+				shard.at(271, 3).decode_failed();
+			}
+		}};
+	}
+	for (auto& w : workers) { w.join(); }
+
+	auto const out = stats.dump(namer);
+	EXPECT_NE(std::string::npos, out.find("diameter_messages_total{command=\"Capabilities-Exchange-Request\",app=\"0\"} 200\n")) << out;
+	EXPECT_NE(std::string::npos, out.find("diameter_bytes_total{command=\"Capabilities-Exchange-Request\",app=\"0\"} 20000\n")) << out;
+	EXPECT_NE(std::string::npos, out.find("diameter_decode_failures_total{command=\"271\",app=\"3\"} 200\n")) << out;
+	EXPECT_NE(std::string::npos, out.find("diameter_latency_ns{command=\"Capabilities-Exchange-Request\",app=\"0\",stage=\"decode\",quantile=\"0.99\"} 200\n")) << out;
+	EXPECT_NE(std::string::npos, out.find("diameter_latency_ns_count{command=\"Capabilities-Exchange-Request\",app=\"0\",stage=\"decode\"} 200\n")) << out;
+	EXPECT_EQ(std::string::npos, out.find("stage=\"encode\"")) << out;
+}
+
+TEST(metrics, overflow)
+{
+	diameter::metrics stats;
+	auto& shard = stats.add_shard();
+	for (uint32_t app = 0; app < 2 * diameter::metrics::MAX_COMMANDS; ++app) { shard.at(272, app).count(1); }
+	auto const out = stats.dump([](uint32_t) -> char const* { return nullptr; });
+	EXPECT_NE(std::string::npos, out.find("diameter_messages_total{command=\"other\",app=\"\"} 65\n")) << out;
+}
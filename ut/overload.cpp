@@ -0,0 +1,50 @@
+#include "diameter/overload.hpp"
+
+#include "ut.hpp"
+
+using namespace diameter;
+using namespace std::chrono_literals;
+
+TEST(overload, state)
+{
+	overload_state oc;
+	auto const now = overload_state::clock::now();
+	EXPECT_EQ(0, oc.reduction(now));
+	EXPECT_TRUE(oc.admit(now));
+
+	EXPECT_TRUE(oc.update(5, 100, 10s, now));
+	EXPECT_EQ(100, oc.reduction(now));
+	EXPECT_FALSE(oc.admit(now));
+	//stale sequence
+	EXPECT_FALSE(oc.update(4, 0, 10s, now));
+	EXPECT_FALSE(oc.update(5, 0, 10s, now));
+	EXPECT_EQ(100, oc.reduction(now + 9s));
+	EXPECT_EQ(0, oc.reduction(now + 10s));
+
+	EXPECT_TRUE(oc.update(6, 50, 10s, now));
+	std::size_t admitted = 0;
+	for (std::size_t i = 0; i < 10000; ++i) { admitted += oc.admit(now); }
+	EXPECT_GT(admitted, 4000);
+	EXPECT_LT(admitted, 6000);
+
+	//end of overload
+	EXPECT_TRUE(oc.update(7, 50, 0s, now));
+	EXPECT_TRUE(oc.admit(now));
+}
+
+TEST(overload, control)
+{
+	overload_control ctl;
+	auto const now = overload_state::clock::now();
+	EXPECT_TRUE(ctl.admit({}, "example.net", 4, now));
+
+	ctl.state(OC_REPORT_TYPE::REALM_REPORT, "example.net", 4).update(1, 100, 30s, now);
+	ctl.state(OC_REPORT_TYPE::HOST_REPORT, "ocs1.example.net", 4).update(1, 100, 30s, now);
+	EXPECT_EQ(&ctl.state(OC_REPORT_TYPE::HOST_REPORT, "ocs1.example.net", 4)
+		, &ctl.state(OC_REPORT_TYPE::HOST_REPORT, "ocs1.example.net", 4));
+
+	EXPECT_FALSE(ctl.admit({}, "example.net", 4, now));
+	EXPECT_TRUE(ctl.admit({}, "example.net", 16777238, now));
+	EXPECT_FALSE(ctl.admit("ocs1.example.net", "example.net", 4, now));
+	EXPECT_TRUE(ctl.admit("ocs2.example.net", "example.net", 4, now));
+}
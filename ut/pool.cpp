@@ -0,0 +1,141 @@
+#include <string_view>
+
+#include "med/decoder_context.hpp"
+#include "med/octet_decoder.hpp"
+#include "med/decode.hpp"
+
+#include "diameter/base.hpp"
+#include "diameter/pool.hpp"
+#include "diameter/writer.hpp"
+
+#include "ut.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+struct message
+{
+	int  value{0};
+	bool set{false};
+	static inline std::size_t s_constructed = 0;
+
+	message()                               { ++s_constructed; }
+	void clear()                            { set = false; }
+};
+
+//CER with mandatory fields and (if full) multi-instance and lazy grouped ones
+std::size_t make_cer(uint8_t (&buffer)[512], bool full)
+{
+	uint8_t const ip4[] = {10, 0, 0, 1};
+	uint8_t const ip4_2[] = {10, 0, 0, 2};
+	diameter::avp_writer w{buffer, sizeof(buffer)};
+	w.header(diameter::REQUEST | diameter::CER::code, 0, 0x22222222, 0x55555555);
+	w.add<diameter::origin_host>("Orig.Host"sv);
+	w.add<diameter::origin_realm>("orig.realm.net"sv);
+	w.add<diameter::host_ip_address>(diameter::ip_address{ip4, sizeof(ip4)});
+	if (full) { w.add<diameter::host_ip_address>(diameter::ip_address{ip4_2, sizeof(ip4_2)}); }
+	w.add<diameter::vendor_id>(diameter::VENDOR::NONE);
+	w.add<diameter::product_name>("base:dia"sv);
+	if (full)
+	{
+		w.add<diameter::origin_state_id>(7u);
+		w.add<diameter::supported_vendor_id>(diameter::VENDOR::TGPP);
+		w.add<diameter::supported_vendor_id>(diameter::VENDOR::NOKIA);
+		for (auto app : {diameter::APPLICATION::S6A, diameter::APPLICATION::GX})
+		{
+			auto const id = w.begin_group<diameter::vendor_specific_application_id>();
+			w.add<diameter::vendor_id>(diameter::VENDOR::TGPP);
+			w.add<diameter::auth_application_id>(app);
+			w.end_group(id);
+		}
+	}
+	return w.finish();
+}
+
+template <class DIA>
+void decode_into(DIA& dia, uint8_t const* data, std::size_t size, med::allocator& alloc)
+{
+	med::decoder_context<med::allocator> ctx{data, size, &alloc};
+	decode(med::octet_decoder{ctx}, dia);
+}
+
+} //end: namespace
+
+TEST(pool, reuse)
+{
+	diameter::pool<message, 2> msgs;
+	EXPECT_EQ(2, message::s_constructed);
+	EXPECT_EQ(2, msgs.available());
+
+	message* first = nullptr;
+	{
+		auto m1 = msgs.acquire();
+		ASSERT_TRUE(m1);
+		m1->set = true;
+		m1->value = 1;
+		first = m1.get();
+
+		auto m2 = msgs.acquire();
+		ASSERT_TRUE(m2);
+		EXPECT_NE(m1.get(), m2.get());
+		EXPECT_EQ(0, msgs.available());
+		EXPECT_FALSE(msgs.acquire());
+	}
+	EXPECT_EQ(2, msgs.available());
+
+	//last released is reused first, reset but not constructed again
+	auto m = msgs.acquire();
+	EXPECT_EQ(first, m.get());
+	EXPECT_FALSE(m->set);
+	EXPECT_EQ(2, message::s_constructed);
+}
+
+TEST(pool, base)
+{
+	diameter::pool<diameter::base, 1> msgs;
+	std::size_t alloc_buf[1024];
+	med::allocator alloc{alloc_buf};
+	uint8_t buffer[512];
+
+	{
+		auto dia = msgs.acquire();
+		ASSERT_TRUE(dia);
+		decode_into(*dia, buffer, make_cer(buffer, true), alloc);
+		diameter::CER const* cer = dia->cselect();
+		ASSERT_NE(nullptr, cer);
+		EXPECT_EQ(2, cer->count<diameter::host_ip_address>());
+		EXPECT_EQ(2, cer->count<diameter::supported_vendor_id>());
+		EXPECT_EQ(2, cer->count<diameter::vendor_specific_application_id>());
+	}
+
+	//other message in the released one
+	{
+		auto dia = msgs.acquire();
+		ASSERT_TRUE(dia);
+		diameter::avp_writer w{buffer, sizeof(buffer)};
+		w.header(diameter::REQUEST | diameter::DWR::code, 0, 0x22222222, 0x55555555);
+		w.add<diameter::origin_host>("Orig.Host"sv);
+		w.add<diameter::origin_realm>("orig.realm.net"sv);
+		decode_into(*dia, buffer, w.finish(), alloc);
+		diameter::CER const* cer = dia->cselect();
+		EXPECT_EQ(nullptr, cer);
+		diameter::DWR const* dwr = dia->cselect();
+		ASSERT_NE(nullptr, dwr);
+		EXPECT_EQ(nullptr, dwr->get<diameter::origin_state_id>());
+	}
+
+	//same message with fewer fields: none of the first one is left
+	{
+		auto dia = msgs.acquire();
+		ASSERT_TRUE(dia);
+		decode_into(*dia, buffer, make_cer(buffer, false), alloc);
+		diameter::CER const* cer = dia->cselect();
+		ASSERT_NE(nullptr, cer);
+		EXPECT_EQ(1, cer->count<diameter::host_ip_address>());
+		EXPECT_EQ(nullptr, cer->get<diameter::origin_state_id>());
+		EXPECT_EQ(0, cer->count<diameter::supported_vendor_id>());
+		EXPECT_EQ(0, cer->count<diameter::vendor_specific_application_id>());
+	}
+	EXPECT_EQ(1, msgs.available());
+}
@@ -0,0 +1,70 @@
+#include "diameter/redirect.hpp"
+
+#include "ut.hpp"
+
+using namespace diameter;
+using namespace std::chrono_literals;
+
+TEST(redirect, scopes)
+{
+	redirect_cache cache;
+	auto const now = redirect_cache::clock::now();
+
+	redirect_cache::request_key const req{"pgw;1;2", "example.net", "hss1.example.net", "001010123456789", 16777251};
+	EXPECT_EQ(nullptr, cache.find(req, now));
+
+	cache.add(REDIRECT_HOST_USAGE::DONT_CACHE, req, {"aaa://x"}, 60s, now);
+	EXPECT_EQ(0, cache.size());
+
+	cache.add(REDIRECT_HOST_USAGE::ALL_REALM, req, {"aaa://realm"}, 60s, now);
+	cache.add(REDIRECT_HOST_USAGE::REALM_AND_APPLICATION, req, {"aaa://app"}, 60s, now);
+	EXPECT_EQ(2, cache.size());
+
+	//more specific scope wins
+	auto const* hosts = cache.find(req, now);
+	ASSERT_NE(nullptr, hosts);
+	EXPECT_EQ("aaa://app", hosts->front());
+
+	//other application of same realm
+	auto other = req;
+	other.app = 4;
+	hosts = cache.find(other, now);
+	ASSERT_NE(nullptr, hosts);
+	EXPECT_EQ("aaa://realm", hosts->front());
+
+	other.realm = "other.net";
+	EXPECT_EQ(nullptr, cache.find(other, now));
+
+	cache.add(REDIRECT_HOST_USAGE::ALL_SESSION, req, {"aaa://s1", "aaa://s2"}, 10s, now);
+	hosts = cache.find(req, now + 5s);
+	ASSERT_NE(nullptr, hosts);
+	EXPECT_EQ(2, hosts->size());
+
+	//session entry expired
+	hosts = cache.find(req, now + 10s);
+	ASSERT_NE(nullptr, hosts);
+	EXPECT_EQ("aaa://app", hosts->front());
+	EXPECT_EQ(2, cache.size());
+
+	cache.purge(now + 60s);
+	EXPECT_EQ(0, cache.size());
+	EXPECT_EQ(nullptr, cache.find(req, now + 60s));
+}
+
+TEST(redirect, missing_scope)
+{
+	redirect_cache cache;
+	auto const now = redirect_cache::clock::now();
+
+	//no User-Name: not cached for all users without one
+	redirect_cache::request_key const anon{"pgw;1;2", "example.net", {}, {}, 4};
+	cache.add(REDIRECT_HOST_USAGE::ALL_USER, anon, {"aaa://user"}, 60s, now);
+	cache.add(REDIRECT_HOST_USAGE::ALL_HOST, anon, {"aaa://host"}, 60s, now);
+	EXPECT_EQ(0, cache.size());
+
+	redirect_cache::request_key const req{"pgw;1;3", "example.net", "hss1.example.net", "001010123456789", 4};
+	cache.add(REDIRECT_HOST_USAGE::ALL_USER, req, {"aaa://user"}, 60s, now);
+	EXPECT_EQ(1, cache.size());
+	EXPECT_NE(nullptr, cache.find(req, now));
+	EXPECT_EQ(nullptr, cache.find(anon, now));
+}
@@ -0,0 +1,106 @@
+#include <string>
+
+#include "diameter/routing.hpp"
+
+#include "ut.hpp"
+
+using namespace diameter;
+
+TEST(routing, longest_suffix)
+{
+	route_table table;
+	table.add("", ANY_APPLICATION, route{LOCAL_ACTION::RELAY, {"default.dra"}});
+	table.add("example.net", ANY_APPLICATION, route{LOCAL_ACTION::PROXY, {"dra1", "dra2"}});
+	table.add("example.net", 4, route{LOCAL_ACTION::RELAY, {"ocs"}});
+	table.add("home.example.net", 16777238, route{LOCAL_ACTION::LOCAL, {}});
+	table.add("visited.net", 16777238, route{LOCAL_ACTION::REDIRECT, {"redirect.visited.net"}});
+	ASSERT_EQ(5, table.size());
+
+	route const* r = table.find("home.example.net", 16777238);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(LOCAL_ACTION::LOCAL, r->action);
+
+	r = table.find("HOME.Example.NET", 4);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(LOCAL_ACTION::RELAY, r->action);
+	ASSERT_EQ(1, r->peers.size());
+	EXPECT_EQ("ocs", r->peers[0]);
+
+	r = table.find("a.b.example.net", 1);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(LOCAL_ACTION::PROXY, r->action);
+	EXPECT_EQ(2, r->peers.size());
+
+	//no suffix match on partial label
+	r = table.find("myexample.net", 1);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("default.dra", r->peers[0]);
+
+	r = table.find("visited.net", 1);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("default.dra", r->peers[0]);
+
+	//replace existing route
+	table.add("Example.Net", 4, route{LOCAL_ACTION::PROXY, {"ocs2"}});
+	EXPECT_EQ(5, table.size());
+	r = table.find("example.net", 4);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("ocs2", r->peers[0]);
+
+	route_table empty;
+	EXPECT_EQ(nullptr, empty.find("example.net", 1));
+}
+
+TEST(routing, many_labels)
+{
+	route_table table;
+	table.add("", ANY_APPLICATION, route{LOCAL_ACTION::RELAY, {"default.dra"}});
+	table.add("example.net", ANY_APPLICATION, route{LOCAL_ACTION::PROXY, {"dra"}});
+
+	std::string realm;
+	for (int i = 0; i < 40; ++i) { realm += "l."; }
+	realm += "example.net";
+	table.add(realm, 4, route{LOCAL_ACTION::LOCAL, {}});
+
+	route const* r = table.find(realm, 4);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(LOCAL_ACTION::LOCAL, r->action);
+
+	r = table.find("x." + realm, 4);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ(LOCAL_ACTION::LOCAL, r->action);
+
+	r = table.find(realm, 1);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("dra", r->peers[0]);
+
+	r = table.find("x.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.l.net", 1);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("default.dra", r->peers[0]);
+}
+
+TEST(routing, cache_update)
+{
+	router rt;
+	route_cache cache{rt};
+	EXPECT_EQ(nullptr, cache.find("example.net", 4));
+
+	auto t1 = std::make_shared<route_table>();
+	t1->add("example.net", ANY_APPLICATION, route{LOCAL_ACTION::RELAY, {"dra1"}});
+	rt.update(t1);
+
+	route const* r = cache.find("ocs.example.net", 4);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("dra1", r->peers[0]);
+	EXPECT_EQ(r, cache.find("ocs.example.net", 4));
+	EXPECT_EQ(nullptr, cache.find("other.org", 4));
+
+	auto t2 = std::make_shared<route_table>();
+	t2->add("ocs.example.net", 4, route{LOCAL_ACTION::PROXY, {"dra2"}});
+	rt.update(t2);
+
+	r = cache.find("ocs.example.net", 4);
+	ASSERT_NE(nullptr, r);
+	EXPECT_EQ("dra2", r->peers[0]);
+	EXPECT_EQ(nullptr, cache.find("www.example.net", 4));
+}
@@ -0,0 +1,100 @@
+#include <string_view>
+
+#include "diameter/base.hpp"
+#include "diameter/scan.hpp"
+
+#include "ut.hpp"
+#include "str.hpp"
+
+using namespace std::string_view_literals;
+
+TEST(scan, header)
+{
+	diameter::header_view hdr;
+	ASSERT_TRUE(hdr.parse(str_encoded, sizeof(str_encoded)));
+	EXPECT_EQ(sizeof(str_encoded), hdr.length);
+	EXPECT_TRUE(hdr.request());
+	EXPECT_EQ(275, hdr.code);
+	EXPECT_EQ(0x80000000 | 275, hdr.tag());
+	EXPECT_EQ(uint32_t(diameter::APPLICATION::GX), hdr.app_id);
+	EXPECT_EQ(0x22222222, hdr.hop_id);
+	EXPECT_EQ(0x55555555, hdr.end_id);
+
+	EXPECT_FALSE(hdr.parse(str_encoded, diameter::header_view::SIZE - 1));
+
+	uint8_t encoded[diameter::header_view::SIZE];
+	hdr.encode(encoded);
+	EXPECT_TRUE(Matches(str_encoded, encoded, sizeof(encoded)));
+
+	encoded[0] = 2;
+	EXPECT_FALSE(hdr.parse(encoded, sizeof(encoded)));
+	EXPECT_EQ(2, hdr.version);
+}
+
+TEST(scan, avps)
+{
+	diameter::avp_reader reader{str_encoded + 20, sizeof(str_encoded) - 20};
+	uint32_t const codes[] = {263, 264, 296, 1000, 283, 258, 295, 293};
+	auto const* code = codes;
+	diameter::avp_view avp;
+	while (reader.next(avp))
+	{
+		ASSERT_NE(std::end(codes), code);
+		EXPECT_EQ(*code++, avp.code);
+		if (avp.code == 1000)
+		{
+			EXPECT_EQ(uint32_t(diameter::VENDOR::TGPP), avp.vendor);
+			uint32_t v32 = 0;
+			ASSERT_TRUE(avp.get(v32));
+			EXPECT_EQ(1, v32);
+			uint64_t v64;
+			EXPECT_FALSE(avp.get(v64));
+		}
+	}
+	EXPECT_FALSE(reader.error());
+	EXPECT_EQ(std::end(codes), code);
+}
+
+TEST(scan, partial)
+{
+	diameter::partial<
+		diameter::session_id,
+		diameter::destination_realm,
+		diameter::destination_host,
+		diameter::auth_application_id
+	> routing;
+
+	ASSERT_TRUE(routing.decode(str_encoded, sizeof(str_encoded)));
+	EXPECT_TRUE(routing.complete());
+	EXPECT_EQ(275, routing.header().code);
+
+	ASSERT_NE(nullptr, routing.get<diameter::session_id>());
+	EXPECT_EQ("host;1;2"sv, routing.get<diameter::session_id>()->str());
+	ASSERT_NE(nullptr, routing.get<diameter::destination_realm>());
+	EXPECT_EQ("dest.realm.net"sv, routing.get<diameter::destination_realm>()->str());
+	ASSERT_NE(nullptr, routing.get<diameter::destination_host>());
+	EXPECT_EQ("Dest.Host"sv, routing.get<diameter::destination_host>()->str());
+	ASSERT_NE(nullptr, routing.get<diameter::auth_application_id>());
+	uint32_t app_id;
+	ASSERT_TRUE(routing.get<diameter::auth_application_id>()->get(app_id));
+	EXPECT_EQ(uint32_t(diameter::APPLICATION::GX), app_id);
+
+	diameter::partial<diameter::user_name, diameter::origin_host> other;
+	ASSERT_TRUE(other.decode(str_encoded, sizeof(str_encoded)));
+	EXPECT_FALSE(other.complete());
+	EXPECT_EQ(nullptr, other.get<diameter::user_name>());
+	ASSERT_NE(nullptr, other.get<diameter::origin_host>());
+	EXPECT_EQ("Orig.Host"sv, other.get<diameter::origin_host>()->str());
+}
+
+TEST(scan, malformed)
+{
+	uint8_t buf[sizeof(str_encoded)];
+	std::memcpy(buf, str_encoded, sizeof(buf));
+	buf[20 + 16 + 7] = 0xFF; //Origin-Host length beyond the message
+
+	diameter::partial<diameter::destination_realm> routing;
+	EXPECT_FALSE(routing.decode(buf, sizeof(buf)));
+	//truncated message
+	EXPECT_FALSE(routing.decode(str_encoded, sizeof(str_encoded) - 4));
+}
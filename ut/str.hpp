@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+//encoded STR shared by the tests of scan, compact storage and validation
+inline constexpr uint8_t str_encoded[] = {
+	0x01, 0x00, 0x00, 0xA4, //VER(1), LEN(3)
+	0xC0, 0x00, 0x01, 0x13, //R.P.E.T(1), CMD(3) = 275
+	0x01, 0x00, 0x00, 0x16, //APP-ID = Gx
+	0x22, 0x22, 0x22, 0x22, //H2H-ID
+	0x55, 0x55, 0x55, 0x55, //E2E-ID
+
+	0x00, 0x00, 0x01, 0x07, //AVP-CODE = 263 Session-Id
+	0x40, 0x00, 0x00, 0x10, //V.M.P(1), LEN(3) = 16
+	'h', 'o', 's', 't',
+	';', '1', ';', '2',
+
+	0x00, 0x00, 0x01, 0x08, //AVP-CODE = 264 OrigHost
+	0x40, 0x00, 0x00, 0x11, //V.M.P(1), LEN(3) = 17 + padding
+	'O', 'r', 'i', 'g',
+	'.', 'H', 'o', 's',
+	't',   0,   0,   0,
+
+	0x00, 0x00, 0x01, 0x28, //AVP-CODE = 296 OrigRealm
+	0x40, 0x00, 0x00, 0x16, //V.M.P(1), LEN(3) = 22 + padding
+	'o', 'r', 'i', 'g',
+	'.', 'r', 'e', 'a',
+	'l', 'm', '.', 'n',
+	'e', 't',   0,   0,
+
+	0x00, 0x00, 0x03, 0xE8, //AVP-CODE = 1000 vendor specific
+	0xC0, 0x00, 0x00, 0x10, //V.M.P(1), LEN(3) = 16
+	0x00, 0x00, 0x28, 0xAF, //vendor = 3GPP
+	0x00, 0x00, 0x00, 0x01,
+
+	0x00, 0x00, 0x01, 0x1B, //AVP-CODE = 283 DestRealm
+	0x40, 0x00, 0x00, 0x16, //V.M.P(1), LEN(3) = 22 + padding
+	'd', 'e', 's', 't',
+	'.', 'r', 'e', 'a',
+	'l', 'm', '.', 'n',
+	'e', 't',   0,   0,
+
+	0x00, 0x00, 0x01, 0x02, //AVP-CODE = 258 Auth-App-Id AVP
+	0x40, 0x00, 0x00, 0x0C, //V.M.P(1), LEN(3) = 12
+	0x01, 0x00, 0x00, 0x16, //id = Gx
+
+	0x00, 0x00, 0x01, 0x27, //AVP-CODE = 295 Termination-Cause
+	0x40, 0x00, 0x00, 0x0C, //V.M.P(1), LEN(3) = 12
+	0x00, 0x00, 0x00, 0x01, //LOGOUT
+
+	0x00, 0x00, 0x01, 0x25, //AVP-CODE = 293 DestHost
+	0x40, 0x00, 0x00, 0x11, //V.M.P(1), LEN(3) = 17 + padding
+	'D', 'e', 's', 't',
+	'.', 'H', 'o', 's',
+	't',   0,   0,   0,
+};
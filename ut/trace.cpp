@@ -0,0 +1,73 @@
+#include <thread>
+
+#include "diameter/trace.hpp"
+
+#include "ut.hpp"
+
+TEST(trace, ring)
+{
+	diameter::trace_ring<1024> ring;
+	uint8_t frame[100];
+	for (std::size_t i = 0; i < sizeof(frame); ++i) { frame[i] = uint8_t(i); }
+
+	EXPECT_TRUE(ring.push(diameter::TRACE::RX, frame, 20, 1));
+	EXPECT_TRUE(ring.push(diameter::TRACE::TX, frame, sizeof(frame), 2));
+	std::size_t n = 0;
+	EXPECT_EQ(2, ring.consume([&](diameter::trace_entry const& e)
+	{
+		EXPECT_EQ(++n, e.timestamp);
+		EXPECT_EQ(n == 1 ? diameter::TRACE::RX : diameter::TRACE::TX, e.direction);
+		EXPECT_EQ(n == 1 ? 20 : sizeof(frame), e.size);
+		EXPECT_TRUE(Matches(frame, e.data, e.size));
+	}));
+	EXPECT_EQ(0, ring.consume([](auto const&) {}));
+
+	//full: 128 bytes per record
+	std::size_t pushed = 0;
+	while (ring.push(diameter::TRACE::RX, frame, sizeof(frame))) { ++pushed; }
+	EXPECT_EQ(7, pushed);
+	EXPECT_EQ(1, ring.dropped());
+	//too big
+	uint8_t big[600] = {};
+	EXPECT_FALSE(ring.push(diameter::TRACE::RX, big, sizeof(big)));
+	EXPECT_EQ(pushed, ring.consume([](auto const&) {}));
+
+	//wraps around
+	for (std::size_t i = 0; i < 20; ++i)
+	{
+		ASSERT_TRUE(ring.push(diameter::TRACE::TX, frame, sizeof(frame), i));
+		EXPECT_EQ(1, ring.consume([&](diameter::trace_entry const& e)
+		{
+			EXPECT_EQ(i, e.timestamp);
+			EXPECT_TRUE(Matches(frame, e.data, e.size));
+		}));
+	}
+}
+
+TEST(trace, threads)
+{
+	diameter::trace_ring<4096> ring;
+	constexpr uint64_t COUNT = 20000;
+
+	std::thread producer{[&]
+	{
+		for (uint64_t i = 0; i < COUNT; )
+		{
+			if (ring.push(diameter::TRACE::RX, &i, sizeof(i), i)) { ++i; }
+		}
+	}};
+
+	uint64_t expected = 0;
+	while (expected < COUNT)
+	{
+		ring.consume([&](diameter::trace_entry const& e)
+		{
+			uint64_t v;
+			std::memcpy(&v, e.data, sizeof(v));
+			ASSERT_EQ(expected, v);
+			ASSERT_EQ(expected, e.timestamp);
+			++expected;
+		});
+	}
+	producer.join();
+}
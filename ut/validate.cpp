@@ -0,0 +1,110 @@
+#include <cstring>
+#include <string_view>
+
+#include "diameter/base.hpp"
+#include "diameter/validate.hpp"
+#include "diameter/writer.hpp"
+
+#include "ut.hpp"
+#include "str.hpp"
+
+using namespace std::string_view_literals;
+
+TEST(validate, message)
+{
+	EXPECT_TRUE(diameter::validate<diameter::STR>(str_encoded, sizeof(str_encoded)));
+	{
+		std::size_t alloc_buf[64];
+		med::allocator alloc{alloc_buf};
+		diameter::base dia;
+		auto const status = diameter::try_decode(dia, str_encoded, sizeof(str_encoded), alloc);
+		EXPECT_EQ(diameter::RESULT::SUCCESS, status.result);
+	}
+
+	//offset of the AVP in message
+	auto const offset_of = [](uint32_t code) -> std::size_t
+	{
+		diameter::avp_reader reader{str_encoded + 20, sizeof(str_encoded) - 20};
+		diameter::avp_view avp;
+		while (reader.next(avp)) { if (avp.code == code) { return avp.begin - str_encoded; } }
+		return 0;
+	};
+
+	uint8_t buf[sizeof(str_encoded)];
+	std::memcpy(buf, str_encoded, sizeof(buf));
+	buf[offset_of(295) + 3] = 0xFF; //Termination-Cause -> unknown AVP
+	auto status = diameter::validate<diameter::STR>(buf, sizeof(buf));
+	EXPECT_EQ(diameter::RESULT::MISSING_AVP, status.result);
+	EXPECT_EQ(295, status.avp_code);
+	EXPECT_EQ(0, status.length);
+
+	std::memcpy(buf, str_encoded, sizeof(buf));
+	std::size_t const dest_host = offset_of(293);
+	buf[dest_host + 3] = 0x08; //Destination-Host -> Origin-Host
+	status = diameter::validate<diameter::STR>(buf, sizeof(buf));
+	EXPECT_EQ(diameter::RESULT::AVP_OCCURS_TOO_MANY_TIMES, status.result);
+	EXPECT_EQ(264, status.avp_code);
+	EXPECT_EQ(dest_host, status.offset);
+	EXPECT_EQ(sizeof(str_encoded) - 3 - dest_host, status.length);
+
+	std::memcpy(buf, str_encoded, sizeof(buf));
+	buf[20 + 16 + 7] = 0xFF; //Origin-Host length beyond the message
+	std::size_t alloc_buf[64];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	status = diameter::try_decode(dia, buf, sizeof(buf), alloc);
+	EXPECT_EQ(diameter::RESULT::INVALID_AVP_LENGTH, status.result);
+	EXPECT_EQ(264, status.avp_code);
+	EXPECT_EQ(20 + 16, status.offset);
+
+	//Auth-Application-Id of 2 octets instead of 4
+	std::memcpy(buf, str_encoded, sizeof(buf));
+	std::size_t const app = offset_of(258);
+	buf[app + 7] -= 2;
+	status = diameter::validate<diameter::STR>(buf, sizeof(buf));
+	EXPECT_EQ(diameter::RESULT::INVALID_AVP_LENGTH, status.result);
+	EXPECT_EQ(258, status.avp_code);
+	EXPECT_EQ(app, status.offset);
+	EXPECT_EQ(10, status.length);
+
+	buf[0] = 2;
+	EXPECT_EQ(diameter::RESULT::UNSUPPORTED_VERSION, diameter::try_decode(dia, buf, sizeof(buf), alloc).result);
+	EXPECT_EQ(diameter::RESULT::INVALID_MESSAGE_LENGTH, diameter::try_decode(dia, str_encoded, sizeof(str_encoded) - 4, alloc).result);
+}
+
+TEST(validate, max)
+{
+	static_assert(diameter::detail::field_of<diameter::O<diameter::route_record, med::max<16>>>::max == 16);
+	static_assert(diameter::detail::field_of<diameter::O<diameter::any_avp, med::inf>>::max == diameter::detail::UNBOUNDED);
+	static_assert(diameter::detail::field_of<diameter::M<diameter::session_id>>::single);
+
+	//STR with given number of Route-Record
+	uint8_t buf[4096];
+	auto const make = [&](std::size_t route_records)
+	{
+		diameter::avp_writer w{buf, sizeof(buf)};
+		w.header(diameter::REQUEST | diameter::STR::code, 0, 0x22222222, 0x55555555, diameter::cmd_flags::P);
+		w.add<diameter::session_id>("host;1;2"sv);
+		w.add<diameter::origin_host>("Orig.Host"sv);
+		w.add<diameter::origin_realm>("orig.realm.net"sv);
+		w.add<diameter::destination_realm>("dest.realm.net"sv);
+		w.add<diameter::auth_application_id>(diameter::APPLICATION::GX);
+		w.add<diameter::termination_cause>(diameter::TERMINATION_CAUSE::LOGOUT);
+		for (std::size_t i = 0; i < route_records; ++i) { w.add<diameter::route_record>("dra.realm.net"sv); }
+		return w.finish();
+	};
+
+	std::size_t size = make(diameter::MAX_ROUTE_RECORD);
+	EXPECT_TRUE(diameter::validate<diameter::STR>(buf, size));
+
+	size = make(diameter::MAX_ROUTE_RECORD + 1);
+	auto const status = diameter::validate<diameter::STR>(buf, size);
+	EXPECT_EQ(diameter::RESULT::AVP_OCCURS_TOO_MANY_TIMES, status.result);
+	EXPECT_EQ(diameter::route_record::id, status.avp_code);
+	EXPECT_EQ(size - 24, status.offset); //the last one of 8 + 13 + 3(padding)
+
+	std::size_t alloc_buf[1024];
+	med::allocator alloc{alloc_buf};
+	diameter::base dia;
+	EXPECT_EQ(diameter::RESULT::AVP_OCCURS_TOO_MANY_TIMES, diameter::try_decode(dia, buf, size, alloc).result);
+}